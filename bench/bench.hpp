@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <thread>
+#include <iostream>
+#include <algorithm>
+
+#include <linq/enumerable.hpp>
+
+namespace linq::bench
+{
+
+	/// <summary>
+	/// A benchmark, registered before main runs. It receives the number of
+	/// elements to process.
+	/// </summary>
+	struct benchmark_case
+	{
+		const char * name;
+		void      (* run)(std::size_t);
+	};
+
+	/// <summary>
+	/// Returns all registered benchmarks
+	/// </summary>
+	inline std::vector<benchmark_case> & registry()
+	{
+		static std::vector<benchmark_case> cases;
+		return cases;
+	}
+
+	/// <summary>
+	/// Registers a benchmark through its constructor
+	/// </summary>
+	struct registrar
+	{
+		registrar(const char * name, void (* run)(std::size_t))
+		{
+			registry().push_back(benchmark_case{ name, run });
+		}
+	};
+
+	/// <summary>
+	/// Random generator with a fixed seed, so every run measures the same input
+	/// </summary>
+	inline std::mt19937_64 & random()
+	{
+		static std::mt19937_64 generator(0xBE4C4);
+		return generator;
+	}
+
+	/// <summary>
+	/// Returns a uniformly distributed number in [0, bound)
+	/// </summary>
+	inline std::size_t random_below(const std::size_t bound)
+	{
+		return static_cast<std::size_t>(random()() % bound);
+	}
+
+	/// <summary>
+	/// Returns the thread counts to measure scaling with: the powers of
+	/// two below the number of hardware threads and that number itself
+	/// </summary>
+	inline std::vector<std::size_t> thread_counts()
+	{
+		const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+		std::vector<std::size_t> counts;
+		for (std::size_t threads = 1; threads < hardware; threads *= 2)
+			counts.push_back(threads);
+
+		counts.push_back(hardware);
+		return counts;
+	}
+
+	/// <summary>
+	/// Labels a measurement with the number of threads it uses
+	/// </summary>
+	inline std::string with_threads(const std::string & label, const std::size_t threads)
+	{
+		return label + ", " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+	}
+
+	/// <summary>
+	/// Keeps the optimizer from dropping a result container. Results
+	/// without a size, like a lookup, report whether they are empty.
+	/// </summary>
+	template<typename TContainer>
+	void consume(const TContainer & result)
+	{
+		static volatile std::size_t sink = 0;
+
+		if constexpr (requires { result.size(); })
+			sink = sink + result.size();
+		else
+			sink = sink + result.any();
+	}
+
+	/// <summary>
+	/// Runs the action a few times and prints the fastest run in milliseconds
+	/// </summary>
+	/// <param name="label">what the action does</param>
+	/// <param name="action">the code to measure, returning its result</param>
+	template<typename TAction>
+	void measure(const std::string & label, const TAction & action)
+	{
+		constexpr int repetitions = 5;
+
+		double fastest = 0;
+		for (int repetition = 0; repetition < repetitions; ++repetition)
+		{
+			const auto start  = std::chrono::steady_clock::now();
+			const auto result = action();
+			const auto stop   = std::chrono::steady_clock::now();
+
+			consume(result);
+
+			const double elapsed = std::chrono::duration<double, std::milli>(stop - start).count();
+			fastest = repetition == 0 ? elapsed : std::min(fastest, elapsed);
+		}
+
+		std::cout << "  " << label << ": " << fastest << " ms\n";
+	}
+
+}
+
+/// <summary>
+/// Defines and registers a benchmark, count names the number of elements
+/// </summary>
+#define LINQ_BENCHMARK(name)                                                          \
+	static void name(std::size_t count);                                              \
+	static const linq::bench::registrar name##_registrar(#name, &name);               \
+	static void name(const std::size_t count)
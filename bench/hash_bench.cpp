@@ -0,0 +1,195 @@
+#include <set>
+#include <string>
+#include <vector>
+#include <utility>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "bench.hpp"
+
+namespace
+{
+
+	struct sale
+	{
+		int key;
+		int amount;
+	};
+
+	std::vector<sale> make_sales(const std::size_t count, const std::size_t distinct_keys)
+	{
+		std::vector<sale> sales(count);
+		for (sale & value : sales)
+			value = sale{ static_cast<int>(linq::bench::random_below(distinct_keys)), static_cast<int>(linq::bench::random_below(1000)) };
+
+		return sales;
+	}
+
+	struct order
+	{
+		int customer;
+		int id;
+	};
+
+	struct customer
+	{
+		long long   id;
+		std::string name;
+	};
+
+	std::vector<order> make_orders(const std::size_t count, const std::size_t customers)
+	{
+		std::vector<order> orders(count);
+		for (std::size_t index = 0; index < count; ++index)
+			orders[index] = order{ static_cast<int>(linq::bench::random_below(customers)), static_cast<int>(index) };
+
+		return orders;
+	}
+
+	std::vector<customer> make_customers(const std::size_t count, const std::size_t ids)
+	{
+		std::vector<customer> customers(count);
+		for (std::size_t index = 0; index < count; ++index)
+			customers[index] = customer{ static_cast<long long>(linq::bench::random_below(ids)), "customer" + std::to_string(index) };
+
+		return customers;
+	}
+
+	std::vector<int> make_numbers(const std::size_t count, const std::size_t distinct_values)
+	{
+		std::vector<int> numbers(count);
+		for (int & value : numbers)
+			value = static_cast<int>(linq::bench::random_below(distinct_values));
+
+		return numbers;
+	}
+
+	std::vector<std::string> make_words(const std::size_t count, const std::size_t distinct_values)
+	{
+		std::vector<std::string> words(count);
+		for (std::string & value : words)
+			value = "word-with-a-long-prefix-" + std::to_string(linq::bench::random_below(distinct_values));
+
+		return words;
+	}
+
+	/// <summary>
+	/// Compares union_with and distinct with the former std::set based union
+	/// and a hand written std::unordered_set loop
+	/// </summary>
+	template<typename TValue>
+	void measure_union(const std::vector<TValue> & lhs, const std::vector<TValue> & rhs)
+	{
+		// the former union_with inserted the rhs and then the lhs into a std::set
+		linq::bench::measure("std::set", [&]
+		{
+			std::vector<TValue> result;
+			std::set<TValue>    seen;
+
+			for (const std::vector<TValue> * values : { &rhs, &lhs })
+			{
+				for (const TValue & value : *values)
+				{
+					const auto inserted = seen.insert(value);
+					if (inserted.second)
+						result.push_back(*inserted.first);
+				}
+			}
+
+			return result;
+		});
+
+		linq::bench::measure("std::unordered_set", [&]
+		{
+			std::vector<TValue>        result;
+			std::unordered_set<TValue> seen;
+
+			for (const std::vector<TValue> * values : { &lhs, &rhs })
+			{
+				for (const TValue & value : *values)
+				{
+					if (seen.insert(value).second)
+						result.push_back(value);
+				}
+			}
+
+			return result;
+		});
+
+		linq::bench::measure("union_with", [&] { return linq::from(lhs).union_with(linq::from(rhs)).to_vector(); });
+		linq::bench::measure("distinct", [&] { return linq::from(lhs).distinct().to_vector(); });
+	}
+
+}
+
+LINQ_BENCHMARK(union_with)
+{
+	std::cout << " integers\n";
+	measure_union(make_numbers(count, count), make_numbers(count, count));
+
+	std::cout << " strings\n";
+	measure_union(make_words(count, count), make_words(count, count));
+}
+
+LINQ_BENCHMARK(group_aggregate)
+{
+	const auto key = [](const sale & value) { return value.key; };
+	const auto sum = [](const long long state, const sale & value) { return state + value.amount; };
+
+	for (const std::size_t distinct_keys : { std::size_t(1000), count / 4 })
+	{
+		const std::vector<sale> sales = make_sales(count, distinct_keys);
+
+		std::cout << " " << distinct_keys << " keys\n";
+
+		linq::bench::measure("std::unordered_map", [&]
+		{
+			std::unordered_map<int, long long> groups;
+			for (const sale & value : sales)
+				groups[value.key] += value.amount;
+
+			return groups;
+		});
+
+		linq::bench::measure("group_aggregate, in memory", [&] { return linq::from(sales).group_aggregate(key, 0ll, sum).to_vector(); });
+
+		// roughly an eighth of the groups fit into the budget
+		const linq::external_hash_policy policy{ distinct_keys * (sizeof(int) + sizeof(long long)) / 8, std::filesystem::temp_directory_path() };
+
+		linq::bench::measure("group_aggregate, spilling", [&] { return linq::from(sales).group_aggregate(key, 0ll, sum, policy).to_vector(); });
+	}
+}
+
+LINQ_BENCHMARK(join_parallel)
+{
+	// the shape of the parallel join test: most orders find one or two customers
+	const std::vector<order>    orders = make_orders(count, count / 10 + 1);
+	const std::vector<customer> people = make_customers(count / 6 + 1, count / 8 + 1);
+
+	const auto order_id    = [](const order & value) { return static_cast<long long>(value.customer); };
+	const auto customer_id = [](const customer & value) { return value.id; };
+	const auto combine     = [](const order & lhs, const customer & rhs) { return std::pair<int, long long>(lhs.id, rhs.id); };
+
+	linq::bench::measure("join, sequential", [&] { return linq::from(orders).join(linq::from(people), order_id, customer_id, combine).to_vector(); });
+
+	for (const std::size_t threads : linq::bench::thread_counts())
+	{
+		const linq::parallel_policy policy{ threads, 0 };
+		linq::bench::measure(linq::bench::with_threads("join", threads), [&] { return linq::from(orders).join(linq::from(people), order_id, customer_id, combine, policy).to_vector(); });
+	}
+}
+
+LINQ_BENCHMARK(to_lookup_parallel)
+{
+	const std::vector<order> orders = make_orders(count, count / 20 + 1);
+	const auto key = [](const order & value) { return value.customer; };
+
+	linq::bench::measure("to_lookup, sequential", [&] { return linq::from(orders).to_lookup(key); });
+
+	for (const std::size_t threads : linq::bench::thread_counts())
+	{
+		const linq::parallel_policy policy{ threads, 0 };
+		linq::bench::measure(linq::bench::with_threads("to_lookup", threads), [&] { return linq::from(orders).to_lookup(key, policy); });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include <string>
+#include <cstring>
+#include <iostream>
+
+#include "bench.hpp"
+
+/// <summary>
+/// Runs every benchmark, or the ones whose name contains the first argument.
+/// The second argument sets the number of elements, one million by default.
+/// </summary>
+int main(int argc, char ** argv)
+{
+	const char *      filter = argc > 1 ? argv[1] : "";
+	const std::size_t count  = argc > 2 ? std::stoull(argv[2]) : 1000000;
+
+	for (const linq::bench::benchmark_case & benchmark : linq::bench::registry())
+	{
+		if (std::strstr(benchmark.name, filter) == nullptr)
+			continue;
+
+		std::cout << benchmark.name << " (" << count << " elements)\n";
+		benchmark.run(count);
+	}
+
+	return 0;
+}
\ No newline at end of file
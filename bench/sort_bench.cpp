@@ -0,0 +1,125 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+
+#include "bench.hpp"
+
+namespace
+{
+
+	struct row
+	{
+		std::int64_t key;
+		double       weight;
+		int          id;
+	};
+
+	std::vector<row> make_rows(const std::size_t count)
+	{
+		std::vector<row> rows(count);
+		for (std::size_t index = 0; index < count; ++index)
+			rows[index] = row{ static_cast<std::int64_t>(linq::bench::random_below(count)), static_cast<double>(index % 1000), static_cast<int>(index) };
+
+		return rows;
+	}
+
+	/// <summary>
+	/// URL-like keys from a few hosts and paths, so they share prefixes
+	/// of several words before the first differing byte
+	/// </summary>
+	std::vector<std::string> make_strings(const std::size_t count)
+	{
+		static const char * hosts[] = { "https://example.com", "https://api.example.com", "https://example.org" };
+		static const char * paths[] = { "/api/v1/customers/", "/api/v1/suppliers/", "/api/v2/customers/" };
+
+		std::vector<std::string> strings(count);
+		for (std::string & value : strings)
+		{
+			value = std::string(hosts[linq::bench::random_below(3)]) + paths[linq::bench::random_below(3)]
+				+ std::to_string(linq::bench::random_below(count / 16 + 1)) + "/orders/" + std::to_string(linq::bench::random_below(1000));
+		}
+
+		return strings;
+	}
+
+	const auto by_key = [](const row & value) { return value.key; };
+
+}
+
+LINQ_BENCHMARK(orderby_key_cache)
+{
+	const std::vector<row> rows = make_rows(count);
+
+	// the key is selected in every comparison, like the sort did before keys were cached
+	const auto expensive_key = [](const row & value) { return std::to_string(value.key); };
+
+	linq::bench::measure("std::stable_sort, key selected per comparison", [&]
+	{
+		std::vector<row> sorted = rows;
+		std::stable_sort(sorted.begin(), sorted.end(), [&](const row & lhs, const row & rhs) { return expensive_key(lhs) < expensive_key(rhs); });
+		return sorted;
+	});
+
+	linq::bench::measure("orderby, key selected once per value", [&] { return linq::from(rows).orderby(expensive_key).to_vector(); });
+
+	linq::bench::measure("std::stable_sort, integer key", [&]
+	{
+		std::vector<row> sorted = rows;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const row & lhs, const row & rhs) { return lhs.key < rhs.key; });
+		return sorted;
+	});
+
+	linq::bench::measure("orderby, integer key", [&] { return linq::from(rows).orderby(by_key).to_vector(); });
+	linq::bench::measure("orderby + take(10)", [&] { return linq::from(rows).orderby(by_key).take(10).to_vector(); });
+}
+
+LINQ_BENCHMARK(orderby_parallel)
+{
+	const std::vector<row> rows = make_rows(count);
+
+	linq::bench::measure("orderby, sequential", [&] { return linq::from(rows).orderby(by_key).to_vector(); });
+
+	for (const std::size_t threads : linq::bench::thread_counts())
+	{
+		const linq::parallel_policy policy{ threads, 0 };
+		linq::bench::measure(linq::bench::with_threads("orderby", threads), [&] { return linq::from(rows).orderby(by_key, policy).to_vector(); });
+	}
+
+	const auto by_weight = [](const row & value) { return value.weight; };
+
+	linq::bench::measure("orderby + thenby, sequential", [&] { return linq::from(rows).orderby(by_weight).thenby(by_key).to_vector(); });
+
+	for (const std::size_t threads : linq::bench::thread_counts())
+	{
+		const linq::parallel_policy policy{ threads, 0 };
+		linq::bench::measure(linq::bench::with_threads("orderby + thenby", threads), [&] { return linq::from(rows).orderby(by_weight, policy).thenby(by_key).to_vector(); });
+	}
+}
+
+LINQ_BENCHMARK(orderby_strings)
+{
+	const std::vector<std::string> strings = make_strings(count);
+
+	linq::bench::measure("std::stable_sort", [&]
+	{
+		std::vector<std::string> sorted = strings;
+		std::stable_sort(sorted.begin(), sorted.end());
+		return sorted;
+	});
+
+	linq::bench::measure("orderby", [&] { return linq::from(strings).orderby([](const std::string & value) { return value; }).to_vector(); });
+	linq::bench::measure("orderby, string_view key", [&] { return linq::from(strings).orderby([](const std::string & value) { return std::string_view(value); }).to_vector(); });
+}
+
+LINQ_BENCHMARK(orderby_external)
+{
+	const std::vector<row> rows = make_rows(count);
+
+	// roughly an eighth of the input fits into the budget
+	const linq::external_sort_policy policy{ count * sizeof(row) / 8, std::filesystem::temp_directory_path() };
+
+	linq::bench::measure("orderby, in memory", [&] { return linq::from(rows).orderby(by_key).to_vector(); });
+	linq::bench::measure("orderby, external", [&] { return linq::from(rows).orderby(by_key, policy).to_vector(); });
+}
\ No newline at end of file
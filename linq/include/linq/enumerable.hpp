@@ -6,6 +6,8 @@
 #include <map>
 #include <queue>
 #include <stack>
+#include <functional>
+#include <optional>
 
 #include <linq/ranges/iterator_range.hpp>
 #include <linq/ranges/repeat_range.hpp>
@@ -13,11 +15,15 @@
 #include <linq/ranges/increment_range.hpp>
 
 #include <linq/ranges/except_range.hpp>
+#include <linq/ranges/except_approx_range.hpp>
 #include <linq/ranges/concat_range.hpp>
 #include <linq/ranges/where_range.hpp>
 #include <linq/ranges/select_range.hpp>
 #include <linq/ranges/intersect_with_range.hpp>
 #include <linq/ranges/distinct_range.hpp>
+#include <linq/ranges/ordered_distinct_range.hpp>
+#include <linq/ranges/distinct_by_range.hpp>
+#include <linq/ranges/external_distinct_range.hpp>
 #include <linq/ranges/skip_range.hpp>
 #include <linq/ranges/take_range.hpp>
 #include <linq/ranges/skip_while_range.hpp>
@@ -28,13 +34,21 @@
 #include <linq/ranges/select_many_range.hpp>
 #include <linq/ranges/pairwise_range.hpp>
 #include <linq/ranges/join_range.hpp>
+#include <linq/ranges/parallel_join_range.hpp>
+#include <linq/ranges/merge_join_range.hpp>
+#include <linq/ranges/group_join_range.hpp>
+#include <linq/ranges/left_join_range.hpp>
+#include <linq/ranges/group_aggregate_range.hpp>
 #include <linq/ranges/union_range.hpp>
+#include <linq/ranges/sorted_set_range.hpp>
 #include <linq/ranges/shuffle_range.hpp>
 #include <linq/ranges/zip_with_range.hpp>
 #include <linq/ranges/container.hpp>
 
 #include <linq/utils/array_traits.hpp>
 #include <linq/utils/concepts.hpp>
+#include <linq/utils/flat_hash_set.hpp>
+#include <linq/utils/prefiltered_set.hpp>
 
 namespace linq
 {
@@ -82,14 +96,50 @@ namespace linq
 		
 		/// <summary>
 		/// Creates a new enumerable which ignores the values
-		/// stored in the except_range
+		/// stored in the except_range. Each remaining value is
+		/// emitted only once. Every lhs value gets inserted into the
+		/// set, so it is a plain hash set without a Bloom filter.
 		/// </summary>
 		/// <param name="collection">an enumerable holding each value to ignore</param>
 		template<range_concept TExceptRange>
-		_NODISCARD enumerable<except_range<range_type, TExceptRange>> except(const enumerable<TExceptRange> & collection) const
+		_NODISCARD enumerable<except_range<range_type, TExceptRange, default_set_t<value_type>>> except(const enumerable<TExceptRange> & collection) const
 		{
-			return enumerable<except_range<range_type, TExceptRange>>(
-				except_range<range_type, TExceptRange>(this->range, collection.get_range())
+			return enumerable<except_range<range_type, TExceptRange, default_set_t<value_type>>>(
+				except_range<range_type, TExceptRange, default_set_t<value_type>>(this->range, collection.get_range(), default_set_t<value_type>(), true)
+			);
+		}
+
+		/// <summary>
+		/// Creates a new enumerable which ignores the values
+		/// stored in the except_range but keeps duplicates of the
+		/// remaining values. Only the ignored values get stored,
+		/// lhs values only probe them, through a Bloom filter once
+		/// the set is large (see prefiltered_set).
+		/// </summary>
+		/// <param name="collection">an enumerable holding each value to ignore</param>
+		template<range_concept TExceptRange>
+		_NODISCARD enumerable<except_range<range_type, TExceptRange, default_probe_set_t<value_type>>> except_with_duplicates(const enumerable<TExceptRange> & collection) const
+		{
+			return enumerable<except_range<range_type, TExceptRange, default_probe_set_t<value_type>>>(
+				except_range<range_type, TExceptRange, default_probe_set_t<value_type>>(this->range, collection.get_range(), default_probe_set_t<value_type>(), false)
+			);
+		}
+
+		/// <summary>
+		/// Creates a new enumerable which ignores the values stored in
+		/// the given range, approximately: only a Bloom filter of those
+		/// values is kept, so about false_positive_rate of the remaining
+		/// values get dropped as well. Duplicates are kept.
+		/// </summary>
+		/// <param name="collection">an enumerable holding each value to ignore</param>
+		/// <param name="false_positive_rate">the rate of values which may be dropped wrongly</param>
+		template<range_concept TExceptRange>
+		_NODISCARD enumerable<except_approx_range<range_type, TExceptRange, hasher<value_type>>> except_approx(const enumerable<TExceptRange> & collection, const double false_positive_rate = 0.01) const
+		{
+			static_assert(hashable_concept<value_type>, "except_approx requires a linq::hasher for the value type");
+
+			return enumerable<except_approx_range<range_type, TExceptRange, hasher<value_type>>>(
+				except_approx_range<range_type, TExceptRange, hasher<value_type>>(this->range, collection.get_range(), hasher<value_type>(), false_positive_rate)
 			);
 		}
 
@@ -140,20 +190,95 @@ namespace linq
 		/// <param name="collection">an enumerable holding the range to compare against</param>
 		/// <returns>an enumerable holding values which both ranges contain</returns>
 		template<range_concept TIntersectsRange>
-		_NODISCARD enumerable<intersect_with_range<range_type, TIntersectsRange>> intersect_with(const enumerable<TIntersectsRange> & collection) const
+		_NODISCARD enumerable<intersect_with_range<range_type, TIntersectsRange, default_probe_set_t<value_type>>> intersect_with(const enumerable<TIntersectsRange> & collection) const
+		{
+			return enumerable<intersect_with_range<range_type, TIntersectsRange, default_probe_set_t<value_type>>>(
+				intersect_with_range<range_type, TIntersectsRange, default_probe_set_t<value_type>>(this->range, collection.get_range(), default_probe_set_t<value_type>())
+			);
+		}
+
+		/// <summary>
+		/// Removes all duplicates from the range, keeping the first
+		/// occurrence of each value in its original order
+		/// </summary>
+		_NODISCARD enumerable<distinct_range<range_type, hasher<value_type>, std::equal_to<value_type>>> distinct() const
+			requires hashable_concept<value_type>
+		{
+			return this->distinct(hasher<value_type>(), std::equal_to<value_type>());
+		}
+
+		/// <summary>
+		/// Removes all duplicates from the range by ordering its values,
+		/// used for value types without a hash function
+		/// </summary>
+		_NODISCARD enumerable<ordered_distinct_range<range_type>> distinct() const
+			requires (!hashable_concept<value_type>)
+		{
+			return enumerable<ordered_distinct_range<range_type>>(
+				ordered_distinct_range<range_type>(this->range)
+			);
+		}
+
+		/// <summary>
+		/// Removes all duplicates from the range within a memory budget,
+		/// keeping the first occurrence of each value in its original order.
+		/// Past the budget, values not seen yet are hash partitioned to disk
+		/// and deduplicated partition by partition once the input ends.
+		/// The values need a linq::hasher and a linq::serializer.
+		/// </summary>
+		/// <param name="policy">the memory budget and the directory for the partition files</param>
+		_NODISCARD enumerable<external_distinct_range<range_type>> distinct(const external_hash_policy & policy) const
+			requires hashable_concept<value_type> && serializable_concept<value_type>
 		{
-			return enumerable<intersect_with_range<range_type, TIntersectsRange>>(
-				intersect_with_range<range_type, TIntersectsRange>(this->range, collection.get_range())
+			return enumerable<external_distinct_range<range_type>>(
+				external_distinct_range<range_type>(this->range, policy)
 			);
 		}
 
 		/// <summary>
-		/// Removes all duplicates from the range
+		/// Removes all duplicates from the range using the given hash
+		/// function and equality, keeping the first occurrence of each
+		/// value in its original order
 		/// </summary>
-		_NODISCARD enumerable<distinct_range<range_type>> distinct() const
+		/// <param name="hash">function hashing a value</param>
+		/// <param name="equal">function comparing two values, has to agree with the hash function</param>
+		template<typename THasher, typename TEqual = std::equal_to<value_type>>
+		_NODISCARD enumerable<distinct_range<range_type, THasher, TEqual>> distinct(const THasher & hash, const TEqual & equal = TEqual()) const
 		{
-			return enumerable<distinct_range<range_type>>(
-				distinct_range<range_type>(this->range)
+			static_assert(std::is_invocable_r_v<size_t, THasher, const value_type &>, "THasher (distinct) has an invalid format!");
+			static_assert(std::is_invocable_r_v<bool, TEqual, const value_type &, const value_type &>, "TEqual (distinct) has an invalid format!");
+
+			return enumerable<distinct_range<range_type, THasher, TEqual>>(
+				distinct_range<range_type, THasher, TEqual>(this->range, hash, equal)
+			);
+		}
+
+		/// <summary>
+		/// Removes all elements whose selected key has been seen before,
+		/// keeping the first element of each key in its original order.
+		/// Only the keys get stored.
+		/// </summary>
+		/// <param name="selector">function to select the key identifying an element</param>
+		template<typename TSelector, typename TKey = std::remove_cvref_t<std::invoke_result_t<TSelector, value_type>>>
+		_NODISCARD enumerable<distinct_by_range<range_type, TSelector, hasher<TKey>, std::equal_to<TKey>>> distinct_by(const TSelector & selector) const
+		{
+			static_assert(hashable_concept<TKey>, "the key selected by distinct_by needs a linq::hasher, pass a hash function otherwise");
+
+			return this->distinct_by(selector, hasher<TKey>(), std::equal_to<TKey>());
+		}
+
+		/// <summary>
+		/// Removes all elements whose selected key has been seen before
+		/// using the given hash function and equality on the keys
+		/// </summary>
+		/// <param name="selector">function to select the key identifying an element</param>
+		/// <param name="hash">function hashing a key</param>
+		/// <param name="equal">function comparing two keys, has to agree with the hash function</param>
+		template<typename TSelector, typename THasher, typename TEqual = std::equal_to<std::remove_cvref_t<std::invoke_result_t<TSelector, value_type>>>>
+		_NODISCARD enumerable<distinct_by_range<range_type, TSelector, THasher, TEqual>> distinct_by(const TSelector & selector, const THasher & hash, const TEqual & equal = TEqual()) const
+		{
+			return enumerable<distinct_by_range<range_type, TSelector, THasher, TEqual>>(
+				distinct_by_range<range_type, TSelector, THasher, TEqual>(this->range, selector, hash, equal)
 			);
 		}
 
@@ -391,6 +516,44 @@ namespace linq
 
 #endif // !max
 
+		/// <summary>
+		/// Determines the element at the zero-based position k after sorting
+		/// the range ascending by the selected key, without sorting it.
+		/// Runs in expected O(n) on a buffered copy of the range.
+		///
+		/// This method throws an index_out_of_bounds_exception
+		/// in case the range holds k or fewer elements
+		/// </summary>
+		/// <param name="k">the rank of the element to select</param>
+		/// <param name="selector">function to select the key to rank by</param>
+		template<typename TSelector, typename = std::enable_if_t<std::is_invocable_v<TSelector, value_type>>>
+		_NODISCARD value_type nth_smallest(const size_t k, const TSelector & selector) const
+		{
+			return this->orderby(selector).element_at(k);
+		}
+
+		/// <summary>
+		/// Determines the median element by the selected key, for an even
+		/// number of elements the lower one of both middle elements.
+		/// Runs in expected O(n) on a buffered copy of the range.
+		///
+		/// If the range is empty, a sequence_empty_exception will
+		/// be thrown
+		/// </summary>
+		/// <param name="selector">function to select the key to rank by</param>
+		template<typename TSelector, typename = std::enable_if_t<std::is_invocable_v<TSelector, value_type>>>
+		_NODISCARD value_type median(const TSelector & selector) const
+		{
+			orderby_range<range_type, TSelector> copy(this->range, selector, true);
+
+			// counting first would iterate the input twice, so the buffer is filled once
+			std::optional<value_type> result = copy.select_median();
+			if (!result)
+				throw sequence_empty_exception();
+
+			return *std::move(result);
+		}
+
 		/// <summary>
 		/// Determines the number of elements held by the range
 		/// </summary>
@@ -652,6 +815,86 @@ namespace linq
 			return transformation(this->aggregate(seed, accumulator));
 		}
 
+		/// <summary>
+		/// groups the values by key and aggregates each group with an accumulator
+		/// starting at a certain seed. Only one accumulator per distinct key is kept,
+		/// the values themselves are never stored. The groups come in the order
+		/// their keys were seen first.
+		/// </summary>
+		/// <typeparam name="TKeySelector">the function-type for key selection</typeparam>
+		/// <typeparam name="TAccumulate">the starting-value for the aggregation of each group</typeparam>
+		/// <typeparam name="TAccumulator">the accumulator to use for each value of a group</typeparam>
+		/// <param name="key_selector">function to select the key of a value</param>
+		/// <param name="seed">the starting value of each group's aggregation</param>
+		/// <param name="accumulator">a function to accumulate a value into the aggregation of its group</param>
+		/// <returns>an enumerable of (key, aggregation) pairs</returns>
+		template<
+			typename TKeySelector,
+			typename TAccumulate,
+			typename TAccumulator,
+			typename TKey = std::remove_cvref_t<std::invoke_result_t<TKeySelector, value_type>>,
+			typename = std::enable_if_t<std::is_same_v<std::invoke_result_t<TAccumulator, TAccumulate, value_type>, TAccumulate>>
+		>
+		_NODISCARD enumerable<group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, default_set_t<TKey>>> group_aggregate(
+			const TKeySelector & key_selector,
+			const TAccumulate & seed,
+			const TAccumulator & accumulator
+		) const
+		{
+			return enumerable<group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, default_set_t<TKey>>>(
+				group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, default_set_t<TKey>>(
+					this->range,
+					key_selector,
+					seed,
+					accumulator,
+					default_set_t<TKey>()
+				)
+			);
+		}
+
+		/// <summary>
+		/// groups the values by key and aggregates each group like group_aggregate,
+		/// keeping the groups held in memory within a budget. Past the budget the
+		/// values of unseen keys are hash partitioned to disk and aggregated
+		/// partition by partition, the result equals the one of group_aggregate.
+		/// The values, keys and aggregations need a linq::serializer.
+		/// </summary>
+		/// <typeparam name="TKeySelector">the function-type for key selection</typeparam>
+		/// <typeparam name="TAccumulate">the starting-value for the aggregation of each group</typeparam>
+		/// <typeparam name="TAccumulator">the accumulator to use for each value of a group</typeparam>
+		/// <param name="key_selector">function to select the key of a value</param>
+		/// <param name="seed">the starting value of each group's aggregation</param>
+		/// <param name="accumulator">a function to accumulate a value into the aggregation of its group</param>
+		/// <param name="policy">the memory budget and the directory for the partition files</param>
+		/// <returns>an enumerable of (key, aggregation) pairs</returns>
+		template<
+			typename TKeySelector,
+			typename TAccumulate,
+			typename TAccumulator,
+			typename TKey = std::remove_cvref_t<std::invoke_result_t<TKeySelector, value_type>>,
+			typename = std::enable_if_t<std::is_same_v<std::invoke_result_t<TAccumulator, TAccumulate, value_type>, TAccumulate>>
+		>
+		_NODISCARD enumerable<group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, flat_hash_set<TKey>>> group_aggregate(
+			const TKeySelector & key_selector,
+			const TAccumulate & seed,
+			const TAccumulator & accumulator,
+			const external_hash_policy & policy
+		) const
+		{
+			static_assert(group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, flat_hash_set<TKey>>::aggregation_type::spillable, "group_aggregate with a memory budget requires hashable keys and a linq::serializer for the values, keys and aggregations");
+
+			return enumerable<group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, flat_hash_set<TKey>>>(
+				group_aggregate_range<range_type, TKeySelector, TAccumulate, TAccumulator, flat_hash_set<TKey>>(
+					this->range,
+					key_selector,
+					seed,
+					accumulator,
+					flat_hash_set<TKey>(),
+					policy
+				)
+			);
+		}
+
 		/// <summary>
 		/// Looks up a specific element at a certain index
 		/// in the range.
@@ -665,6 +908,16 @@ namespace linq
 		_NODISCARD value_type element_at(const size_t index) const
 		{
 			range_type copy = this->range;
+
+			// a sorted range selects the element without sorting everything
+			if constexpr (sorting_range_concept<range_type>)
+			{
+				std::optional<value_type> result = copy.select_nth(index);
+				if (!result)
+					throw index_out_of_bounds_exception();
+
+				return *std::move(result);
+			}
 			
 			size_t current = 0;
 			while (current <= index)
@@ -692,6 +945,9 @@ namespace linq
 		_NODISCARD value_type element_at_default(const size_t index) const
 		{
 			range_type copy = this->range;
+
+			if constexpr (sorting_range_concept<range_type>)
+				return copy.select_nth(index).value_or(value_type{});
 			
 			size_t current = 0;
 			while (current <= index)
@@ -716,6 +972,9 @@ namespace linq
 		_NODISCARD value_type first() const
 		{
 			range_type copy = this->range;
+
+			if constexpr (sorting_range_concept<range_type>)
+				copy.limit_to(1);
 			
 			if (copy.move_next())
 				return copy.get_value();
@@ -731,6 +990,9 @@ namespace linq
 		_NODISCARD value_type first_or_default() const
 		{
 			range_type copy = this->range;
+
+			if constexpr (sorting_range_concept<range_type>)
+				copy.limit_to(1);
 			
 			if (copy.move_next())
 				return copy.get_value();
@@ -794,6 +1056,10 @@ namespace linq
 			// make a copy of the underlying range since we don't want to change it
 			range_type copy = this->range;
 
+			// a sorted range only has to select its smallest element
+			if constexpr (sorting_range_concept<range_type>)
+				copy.limit_to(1);
+
 			// check if the have any value to process
 			if(!copy.move_next())
 			{
@@ -839,9 +1105,18 @@ namespace linq
 		/// If the range is empty, a sequence_empty_exception will
 		/// be thrown
 		/// </summary>
-		_NODISCARD return_type last() const
+		_NODISCARD value_type last() const
 		{
 			range_type copy = this->range;
+
+			if constexpr (sorting_range_concept<range_type>)
+			{
+				std::optional<value_type> result = copy.select_last();
+				if (!result)
+					throw sequence_empty_exception();
+
+				return *std::move(result);
+			}
 			
 			if (!copy.move_next())
 				throw sequence_empty_exception();
@@ -864,6 +1139,9 @@ namespace linq
 		_NODISCARD value_type last_or_default() const
 		{
 			range_type copy = this->range;
+
+			if constexpr (sorting_range_concept<range_type>)
+				return copy.select_last().value_or(value_type{});
 			
 			if (!copy.move_next())
 				return value_type{};
@@ -963,6 +1241,10 @@ namespace linq
 		{
 			// make a copy since the underlying range shouldn't change
 			range_type copy = this->range;
+
+			// a sorted range selects its largest element without sorting everything
+			if constexpr (sorting_range_concept<range_type>)
+				return copy.select_last().value_or(fallback_value);
 			
 			// try to move forward
 			if(!copy.move_next())
@@ -1066,6 +1348,51 @@ namespace linq
 			);
 		}
 
+		/// <summary>
+		/// Sorts the range ascending using the given policy:
+		///
+		/// linq::parallel (or a parallel_policy) sorts on multiple threads,
+		/// an external_sort_policy spills sorted runs to disk beyond its memory budget
+		/// and linq::incremental only sorts as far as the range gets consumed.
+		/// </summary>
+		/// <param name="selector">function to select the key to sort by</param>
+		/// <param name="policy">the policy deciding how the range gets sorted</param>
+		template<typename TSelector, sort_policy_concept TPolicy, typename = std::enable_if_t<std::is_invocable_v<TSelector, value_type>>>
+		_NODISCARD enumerable<orderby_range<range_type, TSelector>> orderby(const TSelector & selector, const TPolicy & policy) const
+		{
+			return orderby_ascending(selector, policy);
+		}
+
+		/// <summary>
+		/// Sorts the range ascending using the given policy
+		/// </summary>
+		/// <param name="selector">function to select the key to sort by</param>
+		/// <param name="policy">the policy deciding how the range gets sorted</param>
+		template<typename TSelector, sort_policy_concept TPolicy, typename = std::enable_if_t<std::is_invocable_v<TSelector, value_type>>>
+		_NODISCARD enumerable<orderby_range<range_type, TSelector>> orderby_ascending(const TSelector & selector, const TPolicy & policy) const
+		{
+			static_assert(!std::is_same_v<TPolicy, external_sort_policy> || serializable_concept<value_type>, "external sorting requires a linq::serializer for the value type");
+
+			return enumerable<orderby_range<range_type, TSelector>>(
+				orderby_range<range_type, TSelector>(this->range, selector, true, make_sort_options(policy))
+			);
+		}
+
+		/// <summary>
+		/// Sorts the range descending using the given policy
+		/// </summary>
+		/// <param name="selector">function to select the key to sort by</param>
+		/// <param name="policy">the policy deciding how the range gets sorted</param>
+		template<typename TSelector, sort_policy_concept TPolicy, typename = std::enable_if_t<std::is_invocable_v<TSelector, value_type>>>
+		_NODISCARD enumerable<orderby_range<range_type, TSelector>> orderby_descending(const TSelector & selector, const TPolicy & policy) const
+		{
+			static_assert(!std::is_same_v<TPolicy, external_sort_policy> || serializable_concept<value_type>, "external sorting requires a linq::serializer for the value type");
+
+			return enumerable<orderby_range<range_type, TSelector>>(
+				orderby_range<range_type, TSelector>(this->range, selector, false, make_sort_options(policy))
+			);
+		}
+
 		template<typename TSelector, typename = std::enable_if_t<std::is_invocable_v<TSelector, value_type>>>
 		_NODISCARD enumerable<thenby_range<range_type, TSelector>> thenby(const TSelector & selector) const
 		{
@@ -1176,6 +1503,15 @@ namespace linq
 			return concatenate_impl<wchar_t>(this->range, separator, capacity);
 		}
 
+		/// <summary>
+		/// Inner hash join on the selected ids. The build side gets loaded
+		/// into a hash table, the other side is streamed and probed against it.
+		/// </summary>
+		/// <param name="enumerable_value">the rhs to join with</param>
+		/// <param name="lhs_id_selection">function to select the id of an lhs value</param>
+		/// <param name="rhs_id_selection">function to select the id of an rhs value</param>
+		/// <param name="join_selection">function to combine two matching values</param>
+		/// <param name="build_side">the side to build the hash table on, preferably the smaller one</param>
 		template<
 			enumerable_concept TEnumerable,
 			typename TLhsIdSelection,
@@ -1191,11 +1527,96 @@ namespace linq
 			const TEnumerable & enumerable_value,
 			const TLhsIdSelection & lhs_id_selection,
 			const TRhsIdSelection & rhs_id_selection,
-			const TJoinSelection & join_selection
+			const TJoinSelection & join_selection,
+			const join_build_side build_side = join_build_side::rhs
 		) const
 		{
 			return enumerable<join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>>(
 				join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>(
+					this->range,
+					enumerable_value.get_range(),
+					lhs_id_selection,
+					rhs_id_selection,
+					join_selection,
+					build_side
+				)
+			);
+		}
+
+		/// <summary>
+		/// Inner hash join on multiple threads. Both sides get loaded and radix
+		/// partitioned by the hash of their ids, the partitions are built and
+		/// probed in parallel. The results are yielded in the order of the
+		/// sequential join, independently of the number of threads.
+		///
+		/// Both id selections get invoked concurrently from several threads and
+		/// have to be thread-safe. The join selection runs on the calling thread.
+		/// </summary>
+		/// <param name="enumerable_value">the rhs to join with</param>
+		/// <param name="lhs_id_selection">function to select the id of an lhs value, invoked concurrently</param>
+		/// <param name="rhs_id_selection">function to select the id of an rhs value, has to be hashable, invoked concurrently</param>
+		/// <param name="join_selection">function to combine two matching values, invoked on the calling thread</param>
+		/// <param name="policy">the parallel policy to respect, e.g. linq::parallel</param>
+		template<
+			enumerable_concept TEnumerable,
+			typename TLhsIdSelection,
+			typename TRhsIdSelection,
+			typename TJoinSelection,
+			typename = std::enable_if_t<
+				std::is_invocable_v<TLhsIdSelection, value_type> &&
+				std::is_invocable_v<TRhsIdSelection, typename TEnumerable::value_type> &&
+				std::is_invocable_v<TJoinSelection, typename range_type::value_type, typename TEnumerable::value_type>
+			>
+		>
+		_NODISCARD enumerable<parallel_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>> join(
+			const TEnumerable & enumerable_value,
+			const TLhsIdSelection & lhs_id_selection,
+			const TRhsIdSelection & rhs_id_selection,
+			const TJoinSelection & join_selection,
+			const parallel_policy & policy
+		) const
+		{
+			return enumerable<parallel_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>>(
+				parallel_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>(
+					this->range,
+					enumerable_value.get_range(),
+					lhs_id_selection,
+					rhs_id_selection,
+					join_selection,
+					policy
+				)
+			);
+		}
+
+		/// <summary>
+		/// Hash group join: every lhs value is combined once with a view of
+		/// all its matching rhs values, which is empty if there is none. The
+		/// view refers to the hash table built from the rhs and can be passed
+		/// to from, the matches are never copied.
+		/// </summary>
+		/// <param name="enumerable_value">the rhs to join with</param>
+		/// <param name="lhs_id_selection">function to select the id of an lhs value</param>
+		/// <param name="rhs_id_selection">function to select the id of an rhs value</param>
+		/// <param name="join_selection">function to combine an lhs value with the view of its matches</param>
+		template<
+			enumerable_concept TEnumerable,
+			typename TLhsIdSelection,
+			typename TRhsIdSelection,
+			typename TJoinSelection,
+			typename = std::enable_if_t<
+				std::is_invocable_v<TLhsIdSelection, value_type> &&
+				std::is_invocable_v<TRhsIdSelection, typename TEnumerable::value_type>
+			>
+		>
+		_NODISCARD enumerable<group_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>> group_join(
+			const TEnumerable & enumerable_value,
+			const TLhsIdSelection & lhs_id_selection,
+			const TRhsIdSelection & rhs_id_selection,
+			const TJoinSelection & join_selection
+		) const
+		{
+			return enumerable<group_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>>(
+				group_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>(
 					this->range,
 					enumerable_value.get_range(),
 					lhs_id_selection,
@@ -1205,6 +1626,87 @@ namespace linq
 			);
 		}
 
+		/// <summary>
+		/// Left outer hash join: every lhs value is combined with each of its
+		/// matching rhs values, or once with a null pointer if there is none.
+		/// Matches are passed as pointers into the loaded rhs, so they never
+		/// get copied. The results follow the order of the lhs.
+		/// </summary>
+		/// <param name="enumerable_value">the rhs to join with</param>
+		/// <param name="lhs_id_selection">function to select the id of an lhs value</param>
+		/// <param name="rhs_id_selection">function to select the id of an rhs value</param>
+		/// <param name="join_selection">function to combine an lhs value with a pointer to an rhs value, null if there is no match</param>
+		template<
+			enumerable_concept TEnumerable,
+			typename TLhsIdSelection,
+			typename TRhsIdSelection,
+			typename TJoinSelection,
+			typename = std::enable_if_t<
+				std::is_invocable_v<TLhsIdSelection, value_type> &&
+				std::is_invocable_v<TRhsIdSelection, typename TEnumerable::value_type> &&
+				std::is_invocable_v<TJoinSelection, typename range_type::value_type, const std::remove_cvref_t<typename TEnumerable::value_type> *>
+			>
+		>
+		_NODISCARD enumerable<left_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>> left_join(
+			const TEnumerable & enumerable_value,
+			const TLhsIdSelection & lhs_id_selection,
+			const TRhsIdSelection & rhs_id_selection,
+			const TJoinSelection & join_selection
+		) const
+		{
+			return enumerable<left_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>>(
+				left_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection>(
+					this->range,
+					enumerable_value.get_range(),
+					lhs_id_selection,
+					rhs_id_selection,
+					join_selection
+				)
+			);
+		}
+
+		/// <summary>
+		/// Inner join of two ranges which are both sorted by their ids.
+		/// Both sides are streamed, only the rhs values sharing the current
+		/// id get buffered, so the memory needed stays bounded.
+		/// </summary>
+		/// <param name="enumerable_value">the rhs to join with, sorted by its ids</param>
+		/// <param name="lhs_id_selection">function to select the id of an lhs value</param>
+		/// <param name="rhs_id_selection">function to select the id of an rhs value</param>
+		/// <param name="join_selection">function to combine two matching values</param>
+		/// <param name="compare">the strict weak ordering both ranges are sorted by</param>
+		template<
+			enumerable_concept TEnumerable,
+			typename TLhsIdSelection,
+			typename TRhsIdSelection,
+			typename TJoinSelection,
+			typename TCompare = std::less<>,
+			typename = std::enable_if_t<
+				std::is_invocable_v<TLhsIdSelection, value_type> &&
+				std::is_invocable_v<TRhsIdSelection, typename TEnumerable::value_type> &&
+				std::is_invocable_v<TJoinSelection, typename range_type::value_type, typename TEnumerable::value_type>
+			>
+		>
+		_NODISCARD enumerable<merge_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection, TCompare>> merge_join(
+			const TEnumerable & enumerable_value,
+			const TLhsIdSelection & lhs_id_selection,
+			const TRhsIdSelection & rhs_id_selection,
+			const TJoinSelection & join_selection,
+			const TCompare & compare = TCompare()
+		) const
+		{
+			return enumerable<merge_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection, TCompare>>(
+				merge_join_range<range_type, TEnumerable, TLhsIdSelection, TRhsIdSelection, TJoinSelection, TCompare>(
+					this->range,
+					enumerable_value.get_range(),
+					lhs_id_selection,
+					rhs_id_selection,
+					join_selection,
+					compare
+				)
+			);
+		}
+
 		template<template<typename, typename> typename TMap = std::map, typename TKeySelection, typename = std::enable_if_t<std::is_invocable_v<TKeySelection, value_type>>>
 		_NODISCARD TMap<std::invoke_result_t<TKeySelection, value_type>, value_type> to_map(const TKeySelection & key_selection) const
 		{
@@ -1264,17 +1766,71 @@ namespace linq
 			return result;
 		}
 		
+		/// <summary>
+		/// Combines the distinct values of both ranges, the values
+		/// of this range first
+		/// </summary>
+		/// <param name="enumerable_range">an enumerable holding the values to append</param>
 		template<typename TEnumerable>
-		_NODISCARD enumerable<union_range<range_type, TEnumerable>> union_with(const TEnumerable & enumerable_range) const
+		_NODISCARD enumerable<union_range<range_type, TEnumerable, default_set_t<value_type>>> union_with(const TEnumerable & enumerable_range) const
 		{
-			return enumerable<union_range<range_type, TEnumerable>>(
-				union_range<range_type, TEnumerable>(
+			return enumerable<union_range<range_type, TEnumerable, default_set_t<value_type>>>(
+				union_range<range_type, TEnumerable, default_set_t<value_type>>(
 					this->range,
-					enumerable_range.get_range()
+					enumerable_range.get_range(),
+					default_set_t<value_type>()
 				)
 			);
 		}
 
+		/// <summary>
+		/// Returns the values both sorted ranges contain.
+		/// Both ranges have to be sorted by compare, they are merged
+		/// in a single pass with constant memory. The result is sorted
+		/// and holds each value once.
+		/// </summary>
+		/// <param name="collection">an enumerable holding the sorted range to merge with</param>
+		/// <param name="compare">the strict weak ordering both ranges are sorted by</param>
+		template<range_concept TOtherRange, typename TCompare = std::less<value_type>>
+		_NODISCARD enumerable<sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::intersection>> sorted_intersect_with(const enumerable<TOtherRange> & collection, const TCompare & compare = TCompare()) const
+		{
+			return enumerable<sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::intersection>>(
+				sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::intersection>(this->range, collection.get_range(), compare)
+			);
+		}
+
+		/// <summary>
+		/// Returns the values contained in either of both sorted ranges.
+		/// Both ranges have to be sorted by compare, they are merged
+		/// in a single pass with constant memory. The result is sorted
+		/// and holds each value once.
+		/// </summary>
+		/// <param name="collection">an enumerable holding the sorted range to merge with</param>
+		/// <param name="compare">the strict weak ordering both ranges are sorted by</param>
+		template<range_concept TOtherRange, typename TCompare = std::less<value_type>>
+		_NODISCARD enumerable<sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::union_of>> sorted_union_with(const enumerable<TOtherRange> & collection, const TCompare & compare = TCompare()) const
+		{
+			return enumerable<sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::union_of>>(
+				sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::union_of>(this->range, collection.get_range(), compare)
+			);
+		}
+
+		/// <summary>
+		/// Returns the values of this sorted range which the other one does not contain.
+		/// Both ranges have to be sorted by compare, they are merged
+		/// in a single pass with constant memory. The result is sorted
+		/// and holds each value once.
+		/// </summary>
+		/// <param name="collection">an enumerable holding the sorted range to merge with</param>
+		/// <param name="compare">the strict weak ordering both ranges are sorted by</param>
+		template<range_concept TOtherRange, typename TCompare = std::less<value_type>>
+		_NODISCARD enumerable<sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::difference>> sorted_except(const enumerable<TOtherRange> & collection, const TCompare & compare = TCompare()) const
+		{
+			return enumerable<sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::difference>>(
+				sorted_set_range<range_type, TOtherRange, TCompare, sorted_set_operation::difference>(this->range, collection.get_range(), compare)
+			);
+		}
+
 		_NODISCARD enumerable<shuffle_range<range_type>> shuffle() const
 		{
 			return enumerable<shuffle_range<range_type>>(
@@ -1290,6 +1846,22 @@ namespace linq
 			return lookup<key_type, value_type>(this->range, selector);
 		}
 
+		/// <summary>
+		/// Builds a lookup on multiple threads: every thread groups a chunk of the
+		/// values into its own partial table, the partials get merged afterwards.
+		/// The keys keep their first-seen order and the values of a key their
+		/// input order, exactly like the sequential to_lookup.
+		/// </summary>
+		/// <param name="selector">function to select the key of a value, invoked concurrently</param>
+		/// <param name="policy">the parallel policy to respect, e.g. linq::parallel</param>
+		template<typename TKeySelector>
+		_NODISCARD lookup<std::invoke_result_t<TKeySelector, value_type>, value_type> to_lookup(const TKeySelector & selector, const parallel_policy & policy) const
+		{
+			using key_type = std::invoke_result_t<TKeySelector, value_type>;
+
+			return lookup<key_type, value_type>(this->range, selector, policy);
+		}
+
 		template<typename TValue, typename = std::enable_if_t<std::is_convertible_v<value_type, TValue>>>
 		_NODISCARD auto cast() const
 		{
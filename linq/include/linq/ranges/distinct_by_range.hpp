@@ -0,0 +1,86 @@
+#pragma once
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/flat_hash_set.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Yields every element whose key has not been seen before. Only the
+	/// keys get stored, so the memory needed depends on the key size and
+	/// not on the size of the elements.
+	/// </summary>
+	template<range_concept TRange, typename TSelector, typename THasher, typename TEqual>
+	class distinct_by_range
+	{
+	public:
+
+		static_assert(std::is_invocable_v<TSelector, typename TRange::value_type>, "typeparam TSelector (distinct_by_range) has an invalid format");
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using range_type    = std::remove_cvref_t<TRange>;
+		using selector_type = std::remove_cvref_t<TSelector>;
+		using hasher_type   = std::remove_cvref_t<THasher>;
+		using equal_type    = std::remove_cvref_t<TEqual>;
+		using value_type    = typename range_type::value_type;
+		using return_type   = typename range_type::return_type;
+		using key_type      = std::remove_cvref_t<std::invoke_result_t<selector_type, value_type>>;
+		using set_type      = flat_hash_set<key_type, hasher_type, equal_type>;
+
+	public:
+
+		/// <summary>
+		/// Creates a distinct_by_range
+		/// </summary>
+		/// <param name="range">the range to operate on</param>
+		/// <param name="selector">function to select the key identifying an element</param>
+		/// <param name="hash">the hash function for the keys</param>
+		/// <param name="equal">the equality comparison for the keys, has to agree with the hash function</param>
+		_NODISCARD_CTOR explicit distinct_by_range(
+			const range_type & range,
+			const selector_type & selector,
+			const hasher_type & hash,
+			const equal_type & equal
+		) : range(range), selector(selector), keys(hash, equal)
+		{
+		}
+
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			return this->range.get_value();
+		}
+
+		/// <summary>
+		/// Moves to the next element with an unseen key
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			while (this->range.move_next())
+			{
+				if (this->keys.insert(this->selector(this->range.get_value())).second)
+					return true;
+			}
+
+			this->keys.clear();
+			return false;
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		range_type    range;
+		selector_type selector;
+		set_type      keys;
+
+	};
+
+}
\ No newline at end of file
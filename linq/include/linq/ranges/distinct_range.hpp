@@ -1,13 +1,16 @@
 #pragma once
 
-#include <set>
-
 #include <linq/utils/concepts.hpp>
+#include <linq/utils/flat_hash_set.hpp>
 
 namespace linq
 {
 
-	template<range_concept TRange>
+	/// <summary>
+	/// Removes duplicates through a flat hash set, the values are
+	/// yielded in the order they are seen first
+	/// </summary>
+	template<range_concept TRange, typename THasher, typename TEqual>
 	class distinct_range
 	{
 	public:
@@ -15,11 +18,13 @@ namespace linq
 		/// <summary>
 		/// Type definitions
 		/// </summary>
-		using range_type        = std::remove_cvref_t<TRange>;
-		using value_type        = std::remove_cvref_t<typename range_type::value_type>;
-		using return_type       = const value_type &;
-		using set_type          = std::set<value_type>;
-		using set_iterator_type = typename set_type::const_iterator;
+		using range_type  = std::remove_cvref_t<TRange>;
+		using value_type  = std::remove_cvref_t<typename range_type::value_type>;
+		using return_type = const value_type &;
+		using hasher_type = std::remove_cvref_t<THasher>;
+		using equal_type  = std::remove_cvref_t<TEqual>;
+		using set_type    = flat_hash_set<value_type, hasher_type, equal_type>;
+		using size_type   = typename set_type::size_type;
 
 	public:
 
@@ -27,8 +32,10 @@ namespace linq
 		/// Creates an distinct_range
 		/// </summary>
 		/// <param name="range">the range to operate on</param>
-		_NODISCARD_CTOR explicit distinct_range(const range_type & range)
-			: range(range), values(), iterator()
+		/// <param name="hash">the hash function</param>
+		/// <param name="equal">the equality comparison, has to agree with the hash function</param>
+		_NODISCARD_CTOR explicit distinct_range(const range_type & range, const hasher_type & hash, const equal_type & equal)
+			: range(range), values(hash, equal), position(0)
 		{
 		}
 
@@ -37,7 +44,7 @@ namespace linq
 		/// </summary>
 		_NODISCARD return_type get_value() const
 		{
-			return *this->iterator;
+			return this->values[this->position];
 		}
 
 		/// <summary>
@@ -48,10 +55,10 @@ namespace linq
 		{
 			while (this->range.move_next())
 			{
-				const auto insertionResult = this->values.insert(this->range.get_value());
-				if(insertionResult.second)
+				const auto insertion_result = this->values.insert(this->range.get_value());
+				if (insertion_result.second)
 				{
-					this->iterator = insertionResult.first;
+					this->position = insertion_result.first;
 					return true;
 				}
 			}
@@ -66,9 +73,9 @@ namespace linq
 		/// Member attributes
 		/// </summary>
 
-		range_type        range;
-		set_type          values;
-		set_iterator_type iterator;
+		range_type range;
+		set_type   values;
+		size_type  position;
 
 	};
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/bloom_filter.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Yields the values of the lhs range which the rhs range does not
+	/// contain, approximately: the rhs range is only kept as a Bloom filter,
+	/// so a few lhs values missing from the rhs range may be dropped as
+	/// well. Duplicates of the lhs range are kept, the memory needed only
+	/// depends on the size of the rhs range and the false positive rate.
+	/// </summary>
+	template<range_concept TLhsRange, range_concept TRhsRange, typename THasher>
+	class except_approx_range
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using lhs_range_type = std::remove_cvref_t<TLhsRange>;
+		using rhs_range_type = std::remove_cvref_t<TRhsRange>;
+		using hasher_type    = std::remove_cvref_t<THasher>;
+		using value_type     = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using return_type    = typename lhs_range_type::return_type;
+
+	public:
+
+		/// <summary>
+		/// Constructs an except_approx_range
+		/// </summary>
+		/// <param name="lhs_range">original range</param>
+		/// <param name="rhs_range">range holding the values to ignore</param>
+		/// <param name="hash">the hash function</param>
+		/// <param name="false_positive_rate">the rate of lhs values which may be dropped wrongly</param>
+		_NODISCARD_CTOR explicit except_approx_range(
+			const lhs_range_type & lhs_range,
+			const rhs_range_type & rhs_range,
+			const hasher_type & hash,
+			const double false_positive_rate
+		) : lhs_range(lhs_range), rhs_range(rhs_range), hash(hash), false_positive_rate(false_positive_rate), filter()
+		{
+		}
+
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			return this->lhs_range.get_value();
+		}
+
+		/// <summary>
+		/// Moves to the next lhs value which the filter rules out
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			if (!this->filter)
+				this->build();
+
+			while (this->lhs_range.move_next())
+			{
+				if (!this->filter->may_contain(this->hash(this->lhs_range.get_value())))
+					return true;
+			}
+
+			return false;
+		}
+
+	private:
+
+		void build()
+		{
+			if constexpr (sized_range_concept<rhs_range_type>)
+			{
+				this->filter.emplace(this->rhs_range.size_hint(), this->false_positive_rate);
+
+				while (this->rhs_range.move_next())
+					this->filter->insert(this->hash(this->rhs_range.get_value()));
+			}
+			else
+			{
+				// the filter has to be sized up front, so only the hashes get buffered
+				std::vector<std::size_t> hashes;
+				while (this->rhs_range.move_next())
+					hashes.push_back(this->hash(this->rhs_range.get_value()));
+
+				this->filter.emplace(hashes.size(), this->false_positive_rate);
+
+				for (const std::size_t hash : hashes)
+					this->filter->insert(hash);
+			}
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		lhs_range_type              lhs_range;
+		rhs_range_type              rhs_range;
+		hasher_type                 hash;
+		double                      false_positive_rate;
+		std::optional<bloom_filter> filter;
+
+	};
+
+}
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
-#include <set>
-
 #include <linq/utils/concepts.hpp>
 
 namespace linq
 {
-	template<range_concept TLhsRange, range_concept TRhsRange>
+	/// <summary>
+	/// Yields the values of the lhs range which the rhs range does not contain.
+	/// The rhs range gets loaded into a set once, lhs values only get probed
+	/// against it. Unless duplicates are kept, each emitted value is added to
+	/// the set so that it is not emitted again.
+	/// </summary>
+	template<range_concept TLhsRange, range_concept TRhsRange, typename TSet>
 	class except_range
 	{
 	public:
@@ -14,12 +18,11 @@ namespace linq
 		/// <summary>
 		/// Type definitions
 		/// </summary>
-		using lhs_range_type    = std::remove_cvref_t<TLhsRange>;
-		using rhs_range_type    = std::remove_cvref_t<TRhsRange>;
-		using value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
-		using return_type       = const value_type &;
-		using set_type          = std::set<value_type>;
-		using set_iterator_type = typename set_type::const_iterator;
+		using lhs_range_type = std::remove_cvref_t<TLhsRange>;
+		using rhs_range_type = std::remove_cvref_t<TRhsRange>;
+		using set_type       = std::remove_cvref_t<TSet>;
+		using value_type     = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using return_type    = typename lhs_range_type::return_type;
 	
 	public:
 
@@ -28,10 +31,14 @@ namespace linq
 		/// </summary>
 		/// <param name="lhs_range">original range</param>
 		/// <param name="rhs_range">range holding the values to ignore</param>
+		/// <param name="values">an empty set carrying the hash function and equality to use</param>
+		/// <param name="distinct">whether each lhs value is emitted only once</param>
 		_NODISCARD_CTOR explicit except_range(
 			const lhs_range_type & lhs_range,
-			const rhs_range_type & rhs_range
-		) : lhs_range(lhs_range), rhs_range(rhs_range), values()//, iterator()
+			const rhs_range_type & rhs_range,
+			const set_type & values,
+			const bool distinct
+		) : lhs_range(lhs_range), rhs_range(rhs_range), values(values), distinct(distinct), loaded(false)
 		{
 		}
 
@@ -40,28 +47,34 @@ namespace linq
 		/// </summary>
 		_NODISCARD return_type get_value() const
 		{
-			return *this->iterator;
+			return this->lhs_range.get_value();
 		}
 
 		/// <summary>
-		/// Inserts the next element in each call
+		/// Moves to the next lhs value which is not excluded
 		/// </summary>
 		_NODISCARD bool move_next()
 		{
-			if(this->values.empty())
+			if (!this->loaded)
 			{
 				// insert all illegal values
 				while (this->rhs_range.move_next())
 					this->values.insert(this->rhs_range.get_value());
+
+				this->loaded = true;
 			}
 
-			// insert a new legal value step by step
-			while(this->lhs_range.move_next())
+			while (this->lhs_range.move_next())
 			{
-				const auto insertionResult = this->values.insert(this->lhs_range.get_value());
-				if(insertionResult.second)
+				const value_type & value = this->lhs_range.get_value();
+
+				if (this->distinct)
+				{
+					if (this->values.insert(value).second)
+						return true;
+				}
+				else if (!this->values.contains(value))
 				{
-					this->iterator = insertionResult.first;
 					return true;
 				}
 			}
@@ -75,11 +88,11 @@ namespace linq
 		/// Member attributes
 		/// </summary>
 		
-		lhs_range_type lhs_range{};
-		rhs_range_type rhs_range{};
-
-		set_type          values{};
-		set_iterator_type iterator{};
+		lhs_range_type lhs_range;
+		rhs_range_type rhs_range;
+		set_type       values;
+		bool           distinct;
+		bool           loaded;
 		
 	};
-}
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/flat_hash_set.hpp>
+#include <linq/utils/hash_aggregation.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Removes duplicates within a memory budget, the values are yielded in
+	/// the order they are seen first, exactly like distinct_range does.
+	///
+	/// Values are yielded right away as long as the set of seen values fits
+	/// into the budget. Past it, duplicates of seen values are still dropped
+	/// right away, while values not seen yet get hash partitioned into
+	/// temporary files. The partitions are deduplicated one by one once the
+	/// input ends and their values are yielded in input order.
+	/// </summary>
+	template<range_concept TRange>
+	class external_distinct_range
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using range_type  = std::remove_cvref_t<TRange>;
+		using value_type  = std::remove_cvref_t<typename range_type::value_type>;
+		using return_type = const value_type &;
+
+	private:
+
+		/// <summary>
+		/// Values are their own keys and carry no state
+		/// </summary>
+		struct no_state
+		{
+		};
+
+		struct select_value
+		{
+			_NODISCARD const value_type & operator()(const value_type & value) const
+			{
+				return value;
+			}
+		};
+
+		struct keep_state
+		{
+			_NODISCARD no_state operator()(const no_state state, const value_type &) const
+			{
+				return state;
+			}
+		};
+
+		using aggregation_type = hash_aggregation<value_type, select_value, no_state, keep_state, flat_hash_set<value_type>>;
+
+	public:
+
+		/// <summary>
+		/// Creates an external_distinct_range
+		/// </summary>
+		/// <param name="range">the range to operate on</param>
+		/// <param name="external">the memory budget</param>
+		_NODISCARD_CTOR explicit external_distinct_range(const range_type & range, const external_hash_policy & external)
+			: range(range),
+			values(select_value(), no_state(), keep_state(), flat_hash_set<value_type>(), external),
+			current(),
+			draining(false)
+		{
+			static_assert(aggregation_type::spillable, "value_type (external_distinct_range) needs a linq::hasher and a linq::serializer!");
+		}
+
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			if (this->draining)
+				return this->values.key();
+
+			return this->current;
+		}
+
+		/// <summary>
+		/// Increments the iterator to get the next value as
+		/// active one
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			if (!this->draining)
+			{
+				while (this->range.move_next())
+				{
+					const auto & value = this->range.get_value();
+
+					if (this->values.add(value) == aggregation_type::add_result::inserted)
+					{
+						this->current = value;
+						return true;
+					}
+				}
+
+				// everything held in memory has already been yielded
+				this->values.finish(false);
+				this->draining = true;
+			}
+
+			return this->values.next();
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		range_type       range;
+		aggregation_type values;
+		value_type       current;
+		bool             draining;
+
+	};
+
+}
\ No newline at end of file
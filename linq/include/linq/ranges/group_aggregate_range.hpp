@@ -0,0 +1,105 @@
+#pragma once
+
+#include <utility>
+#include <optional>
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/hash_aggregation.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Groups the values of a range by key and folds every group into one
+	/// accumulator, starting at the seed. Only the keys and accumulators are
+	/// stored, one of each per distinct key, never the values themselves.
+	///
+	/// Yields (key, accumulator) pairs in the order the keys were seen first.
+	/// With an external_hash_policy the groups held in memory are bounded,
+	/// the rest is aggregated through temporary files (see hash_aggregation).
+	/// </summary>
+	template<range_concept TRange, typename TKeySelector, typename TAccumulate, typename TAccumulator, typename TSet>
+	class group_aggregate_range
+	{
+	public:
+
+		static_assert(std::is_invocable_v<TKeySelector, typename TRange::value_type>, "TKeySelector (group_aggregate_range) has an invalid format!");
+		static_assert(std::is_invocable_r_v<TAccumulate, TAccumulator, TAccumulate, typename TRange::value_type>, "TAccumulator (group_aggregate_range) has an invalid format!");
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using range_type        = std::remove_cvref_t<TRange>;
+		using key_selector_type = std::remove_cvref_t<TKeySelector>;
+		using accumulate_type   = std::remove_cvref_t<TAccumulate>;
+		using accumulator_type  = std::remove_cvref_t<TAccumulator>;
+		using set_type          = std::remove_cvref_t<TSet>;
+		using key_type          = typename set_type::value_type;
+		using aggregation_type  = hash_aggregation<typename range_type::value_type, key_selector_type, accumulate_type, accumulator_type, set_type>;
+		using value_type        = std::pair<key_type, accumulate_type>;
+		using return_type       = value_type;
+
+	public:
+
+		/// <summary>
+		/// Creates a group_aggregate_range
+		/// </summary>
+		/// <param name="range">the range to group</param>
+		/// <param name="key_selector">function to select the key of a value</param>
+		/// <param name="seed">the starting value of every group's aggregation</param>
+		/// <param name="accumulator">function to fold a value into the accumulator of its group</param>
+		/// <param name="keys">an empty set carrying the hash function and equality to use</param>
+		/// <param name="external">the memory budget, none meaning everything stays in memory</param>
+		_NODISCARD_CTOR explicit group_aggregate_range(
+			const range_type & range,
+			const key_selector_type & key_selector,
+			const accumulate_type & seed,
+			const accumulator_type & accumulator,
+			const set_type & keys,
+			const std::optional<external_hash_policy> & external = std::nullopt
+		) : range(range),
+			aggregation(key_selector, seed, accumulator, keys, external),
+			built(false)
+		{
+		}
+
+		/// <summary>
+		/// Returns the current key and its accumulator
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			return value_type(this->aggregation.key(), this->aggregation.state());
+		}
+
+		/// <summary>
+		/// Increments the iterator to get the next value as
+		/// active one
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			if (!this->built)
+			{
+				this->built = true;
+
+				while (this->range.move_next())
+					this->aggregation.add(this->range.get_value());
+
+				this->aggregation.finish(true);
+			}
+
+			return this->aggregation.next();
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		range_type       range;
+		aggregation_type aggregation;
+		bool             built;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <memory>
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/hash_groups.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Yields every lhs value exactly once together with a view of its
+	/// matching rhs values, in the order of the lhs. The rhs gets loaded
+	/// into hash groups once, the views only point into them, so no match
+	/// is ever copied. Lhs values without a match get an empty view.
+	/// </summary>
+	template<
+		range_concept TRange,
+		typename TEnumerable,
+		typename TLhsIdSelection,
+		typename TRhsIdSelection,
+		typename TJoinSelection
+	>
+	class group_join_range
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using enumerable            = std::remove_cvref_t<TEnumerable>;
+		using lhs_range_type        = std::remove_cvref_t<TRange>;
+		using rhs_range_type        = typename enumerable::range_type;
+		using lhs_id_selection_type = std::remove_cvref_t<TLhsIdSelection>;
+		using rhs_id_selection_type = std::remove_cvref_t<TRhsIdSelection>;
+		using join_selection_type   = std::remove_cvref_t<TJoinSelection>;
+		using lhs_value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using rhs_value_type        = std::remove_cvref_t<typename rhs_range_type::value_type>;
+		using rhs_id_type           = std::remove_cvref_t<std::invoke_result_t<rhs_id_selection_type, rhs_value_type>>;
+		using rhs_groups_type       = hash_groups<rhs_id_type, rhs_value_type>;
+		using group_view_type       = hash_group_view<rhs_groups_type>;
+		using join_result           = std::invoke_result_t<join_selection_type, lhs_value_type, group_view_type>;
+		using size_type             = std::size_t;
+
+		using value_type  = join_result;
+		using return_type = value_type;
+
+		static_assert(std::is_invocable_v<TLhsIdSelection, typename TRange::value_type>, "TLhsIdSelection (group_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TRhsIdSelection, typename TEnumerable::range_type::value_type>, "TRhsIdSelection (group_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TJoinSelection, typename TRange::value_type, group_view_type>, "TJoinSelection (group_join_range) has an invalid format!");
+
+	public:
+
+		_NODISCARD_CTOR explicit group_join_range(
+			const lhs_range_type & lhs_range,
+			const rhs_range_type & rhs_range,
+			const lhs_id_selection_type & lhs_id_selection,
+			const rhs_id_selection_type & rhs_id_selection,
+			const join_selection_type & join_selection
+		) : lhs_range(lhs_range),
+			rhs_range(rhs_range),
+			lhs_id_selection(lhs_id_selection),
+			rhs_id_selection(rhs_id_selection),
+			join_selection(join_selection),
+			rhs_groups(),
+			group(rhs_groups_type::npos)
+		{
+		}
+
+		_NODISCARD return_type get_value() const
+		{
+			return this->join_selection(this->lhs_range.get_value(), group_view_type(this->rhs_groups, this->group));
+		}
+
+		_NODISCARD bool move_next()
+		{
+			if (!this->rhs_groups)
+				this->rhs_groups = std::make_shared<const rhs_groups_type>(make_hash_groups<rhs_groups_type>(this->rhs_range, this->rhs_id_selection));
+
+			if (!this->lhs_range.move_next())
+				return false;
+
+			this->group = this->rhs_groups->find(this->lhs_id_selection(this->lhs_range.get_value()));
+			return true;
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		lhs_range_type        lhs_range;
+		rhs_range_type        rhs_range;
+		lhs_id_selection_type lhs_id_selection;
+		rhs_id_selection_type rhs_id_selection;
+		join_selection_type   join_selection;
+
+		std::shared_ptr<const rhs_groups_type> rhs_groups;
+		size_type                              group;
+
+	};
+
+}
\ No newline at end of file
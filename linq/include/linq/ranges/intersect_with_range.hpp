@@ -1,13 +1,24 @@
 #pragma once
 
-#include <set>
+#include <vector>
+#include <utility>
 
 #include <linq/utils/concepts.hpp>
 
 namespace linq
 {
 
-	template<range_concept TLhsRange, range_concept TRhsRange>
+	/// <summary>
+	/// Yields the distinct values of the lhs range which the rhs range
+	/// contains as well, in the order they appear in the lhs range.
+	///
+	/// Only the smaller range gets loaded into a set. If both ranges know
+	/// their size it is picked right away, otherwise both ranges are read
+	/// in lockstep until one of them ends, so the larger range is buffered
+	/// for at most the length of the smaller one. The larger range then
+	/// only gets probed against the set.
+	/// </summary>
+	template<range_concept TLhsRange, range_concept TRhsRange, typename TSet>
 	class intersect_with_range
 	{
 	public:
@@ -15,13 +26,13 @@ namespace linq
 		/// <summary>
 		/// Type definitions
 		/// </summary>
-		using lhs_range_type    = std::remove_cvref_t<TLhsRange>;
-		using rhs_range_type    = std::remove_cvref_t<TRhsRange>;
-		using value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
-		using return_type       = const value_type &;
-		using set_type          = std::set<value_type>;
-		using set_iterator_type = typename set_type::const_iterator;
-	
+		using lhs_range_type = std::remove_cvref_t<TLhsRange>;
+		using rhs_range_type = std::remove_cvref_t<TRhsRange>;
+		using set_type       = std::remove_cvref_t<TSet>;
+		using value_type     = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using return_type    = const value_type &;
+		using size_type      = typename set_type::size_type;
+
 	public:
 
 		/// <summary>
@@ -29,10 +40,20 @@ namespace linq
 		/// </summary>
 		/// <param name="lhs_range">the left-hand-side range</param>
 		/// <param name="rhs_range">the right-hand-side range</param>
+		/// <param name="values">an empty set carrying the hash function and equality to use</param>
 		_NODISCARD_CTOR explicit intersect_with_range(
 			const lhs_range_type & lhs_range,
-			const rhs_range_type & rhs_range
-		) : lhs_range(lhs_range), rhs_range(rhs_range), values(), iterator()
+			const rhs_range_type & rhs_range,
+			const set_type & values
+		) : lhs_range(lhs_range),
+			rhs_range(rhs_range),
+			smaller(values),
+			prefix(values),
+			flags(),
+			lhs_smaller(false),
+			built(false),
+			streaming(false),
+			position(0)
 		{
 		}
 
@@ -41,7 +62,11 @@ namespace linq
 		/// </summary>
 		_NODISCARD return_type get_value() const
 		{
-			return *this->iterator;
+			// before streaming, the current lhs value lives in the buffered prefix
+			if (!this->lhs_smaller && !this->streaming)
+				return this->prefix[this->position];
+
+			return this->smaller[this->position];
 		}
 
 		/// <summary>
@@ -50,41 +75,158 @@ namespace linq
 		/// </summary>
 		_NODISCARD bool move_next()
 		{
-			if(this->values.empty())
+			if (!this->built)
+			{
+				this->build();
+				this->built = true;
+				this->position = set_type::npos;
+			}
+
+			if (this->lhs_smaller)
+			{
+				// the lhs values are in first-seen order, the flags tell which ones the rhs contains
+				while (++this->position < this->smaller.size())
+				{
+					if (this->flags[this->position])
+						return true;
+				}
+
+				this->position = this->smaller.size();
+				return false;
+			}
+
+			// the buffered lhs prefix comes first
+			if (!this->streaming)
 			{
-				// insert the original range
-				while (this->lhs_range.move_next())
+				while (++this->position < this->prefix.size())
 				{
-					this->values.insert(this->lhs_range.get_value());
+					if (this->emit(this->smaller.find(this->prefix[this->position])))
+						return true;
 				}
+
+				this->streaming = true;
 			}
 
-			while (this->rhs_range.move_next())
+			while (this->lhs_range.move_next())
 			{
-				const auto insertionResult = this->values.insert(this->rhs_range.get_value());
-				if(!insertionResult.second)
+				const size_type found = this->smaller.find(this->lhs_range.get_value());
+
+				if (this->emit(found))
 				{
-					this->iterator = insertionResult.first;
+					this->position = found;
 					return true;
 				}
 			}
 
-			this->values.clear();
 			return false;
 		}
 
+	private:
+
+		/// <summary>
+		/// Loads the smaller range into the set, the larger one is either untouched
+		/// or its prefix, read in lockstep, is kept distinct in first-seen order
+		/// </summary>
+		void build()
+		{
+			// a range which returned false from move_next must not be advanced again
+			bool smaller_ended = false;
+
+			if constexpr (sized_range_concept<lhs_range_type> && sized_range_concept<rhs_range_type>)
+			{
+				this->lhs_smaller = this->lhs_range.size_hint() <= this->rhs_range.size_hint();
+			}
+			else
+			{
+				while (true)
+				{
+					if (!this->lhs_range.move_next())
+					{
+						this->lhs_smaller = true;
+						break;
+					}
+
+					this->smaller.insert(this->lhs_range.get_value());
+
+					if (!this->rhs_range.move_next())
+					{
+						this->lhs_smaller = false;
+						break;
+					}
+
+					this->prefix.insert(this->rhs_range.get_value());
+				}
+
+				// the set filled from the smaller range always has to be named smaller
+				if (!this->lhs_smaller)
+					std::swap(this->smaller, this->prefix);
+
+				smaller_ended = true;
+			}
+
+			if (this->lhs_smaller)
+			{
+				while (!smaller_ended && this->lhs_range.move_next())
+					this->smaller.insert(this->lhs_range.get_value());
+
+				this->flags.assign(this->smaller.size(), false);
+
+				// the buffered rhs prefix is only needed for membership
+				for (size_type index = 0; index < this->prefix.size(); ++index)
+					this->mark(this->smaller.find(this->prefix[index]));
+
+				this->prefix.clear();
+
+				while (this->rhs_range.move_next())
+					this->mark(this->smaller.find(this->rhs_range.get_value()));
+			}
+			else
+			{
+				while (!smaller_ended && this->rhs_range.move_next())
+					this->smaller.insert(this->rhs_range.get_value());
+
+				this->flags.assign(this->smaller.size(), false);
+			}
+		}
+
+		/// <summary>
+		/// Remembers that the rhs contains the lhs value at position
+		/// </summary>
+		void mark(const size_type found)
+		{
+			if (found != set_type::npos)
+				this->flags[found] = true;
+		}
+
+		/// <summary>
+		/// Checks whether an lhs value matching the rhs value at position has
+		/// to be emitted, which is the case the first time only
+		/// </summary>
+		_NODISCARD bool emit(const size_type found)
+		{
+			if (found == set_type::npos || this->flags[found])
+				return false;
+
+			this->flags[found] = true;
+			return true;
+		}
+
 	private:
 
 		/// <summary>
 		/// Member attributes
 		/// </summary>
-		
-		lhs_range_type lhs_range;
-		rhs_range_type rhs_range;
 
-		set_type          values;
-		set_iterator_type iterator;
-		
+		lhs_range_type    lhs_range;
+		rhs_range_type    rhs_range;
+		set_type          smaller;
+		set_type          prefix;
+		std::vector<bool> flags;
+		bool              lhs_smaller;
+		bool              built;
+		bool              streaming;
+		size_type         position;
+
 	};
-	
+
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <iterator>
+
 #include <linq/utils/iterator_traits.hpp>
 
 namespace linq
@@ -48,6 +50,15 @@ namespace linq
 			++this->next;
 			return true;
 		}
+
+		/// <summary>
+		/// Returns the number of elements left to process,
+		/// only available for random access iterators
+		/// </summary>
+		_NODISCARD std::size_t size_hint() const requires std::random_access_iterator<iterator>
+		{
+			return static_cast<std::size_t>(this->end - this->next);
+		}
 	
 	private:
 
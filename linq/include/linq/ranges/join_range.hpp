@@ -1,12 +1,28 @@
 #pragma once
 
 #include <linq/utils/concepts.hpp>
-
-#include <map>
+#include <linq/utils/hash_groups.hpp>
 
 namespace linq
 {
 
+	/// <summary>
+	/// The input of a join which gets loaded into the hash table,
+	/// the other one is streamed and probed against it
+	/// </summary>
+	enum class join_build_side
+	{
+		/// <summary>
+		/// build on the rhs, results follow the order of the lhs
+		/// </summary>
+		rhs,
+
+		/// <summary>
+		/// build on the lhs, results follow the order of the rhs
+		/// </summary>
+		lhs
+	};
+
 	template<
 		range_concept TRange,
 		typename TEnumerable,
@@ -21,7 +37,7 @@ namespace linq
 		static_assert(std::is_invocable_v<TLhsIdSelection, typename TRange::value_type>, "TLhsIdSelection (join_range) has an invalid format!");
 		static_assert(std::is_invocable_v<TRhsIdSelection, typename TEnumerable::range_type::value_type>, "TRhsIdSelection (join_range) has an invalid format!");
 		static_assert(std::is_invocable_v<TJoinSelection, typename TRange::value_type, typename TEnumerable::range_type::value_type>, "TJoinSelection (join_range) has an invalid format!");
-		
+
 		/// <summary>
 		/// Type definitions
 		/// </summary>
@@ -33,37 +49,45 @@ namespace linq
 		using join_selection_type   = std::remove_cvref_t<TJoinSelection>;
 		using lhs_value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
 		using rhs_value_type        = std::remove_cvref_t<typename rhs_range_type::value_type>;
-		using lhs_id_type           = std::invoke_result_t<lhs_id_selection_type, lhs_value_type>;
-		using rhs_id_type           = std::invoke_result_t<rhs_id_selection_type, rhs_value_type>;
+		using lhs_id_type           = std::remove_cvref_t<std::invoke_result_t<lhs_id_selection_type, lhs_value_type>>;
+		using rhs_id_type           = std::remove_cvref_t<std::invoke_result_t<rhs_id_selection_type, rhs_value_type>>;
 		using join_result           = std::invoke_result_t<join_selection_type, lhs_value_type, rhs_value_type>;
-		using map_type              = std::multimap<rhs_id_type, rhs_value_type>;
-		using map_iterator_type     = typename map_type::const_iterator;
-		
+		using lhs_groups_type       = hash_groups<rhs_id_type, lhs_value_type>;
+		using rhs_groups_type       = hash_groups<rhs_id_type, rhs_value_type>;
+		using size_type             = std::size_t;
+
 		using value_type  = join_result;
 		using return_type = value_type;
 
 	public:
-		
+
 		_NODISCARD_CTOR explicit join_range(
 			const lhs_range_type & lhs_range,
 			const rhs_range_type & rhs_range,
 			const lhs_id_selection_type & lhs_id_selection,
 			const rhs_id_selection_type & rhs_id_selection,
-			const join_selection_type & join_selection
+			const join_selection_type & join_selection,
+			const join_build_side build_side = join_build_side::rhs
 		) : lhs_range(lhs_range),
 			rhs_range(rhs_range),
 			lhs_id_selection(lhs_id_selection),
 			rhs_id_selection(rhs_id_selection),
 			join_selection(join_selection),
+			build_side(build_side),
 			start(true),
-			map(),
-			current()
+			lhs_groups(),
+			rhs_groups(),
+			position(0),
+			end(0)
 		{
 		}
 
 		_NODISCARD return_type get_value() const
 		{
-			return this->join_selection(this->lhs_range.get_value(), this->current->second);
+			if (this->build_side == join_build_side::rhs)
+				return this->join_selection(this->lhs_range.get_value(), this->rhs_groups[this->position]);
+
+			return this->join_selection(this->lhs_groups[this->position], this->rhs_range.get_value());
 		}
 
 		_NODISCARD bool move_next()
@@ -71,62 +95,80 @@ namespace linq
 			if(this->start)
 			{
 				this->start = false;
-				while(this->rhs_range.move_next())
-				{
-					const auto value = this->rhs_range.get_value();
-					const auto key   = this->rhs_id_selection(value);
-					this->map.insert(std::make_pair(key, value));
-				}
 
-				this->current = this->map.end();
-				if (this->map.empty())
-				{		
-					return false;
-				}
+				if (this->build_side == join_build_side::rhs)
+					this->rhs_groups = make_hash_groups<rhs_groups_type>(this->rhs_range, this->rhs_id_selection);
+				else
+					this->lhs_groups = make_hash_groups<lhs_groups_type>(this->lhs_range, [this](const lhs_value_type & value) { return this->select_lhs_id(value); });
 			}
 
-			if(this->current != this->map.end())
+			// the remaining matches of the current streamed value come first
+			if (this->position + 1 < this->end)
 			{
-				const auto previous = this->current;
-				++this->current;
-
-				if(this->current != this->map.end() && !(previous->first < this->current->first))
-				{
-					return true;
-				}
+				++this->position;
+				return true;
 			}
 
-			while (this->lhs_range.move_next())
+			if (this->build_side == join_build_side::rhs)
+				return this->probe(this->lhs_range, [this](const lhs_value_type & value) { return this->select_lhs_id(value); }, this->rhs_groups);
+
+			return this->probe(this->rhs_range, this->rhs_id_selection, this->lhs_groups);
+		}
+
+	private:
+
+		/// <summary>
+		/// Selects the id of a lhs value converted to the rhs id type,
+		/// both build sides are keyed on the rhs id type
+		/// </summary>
+		_NODISCARD rhs_id_type select_lhs_id(const lhs_value_type & value) const
+		{
+			return static_cast<rhs_id_type>(this->lhs_id_selection(value));
+		}
+
+		/// <summary>
+		/// Streams the probe side until a value with at least one match is found
+		/// </summary>
+		template<typename TProbeRange, typename TIdSelection, typename TGroups>
+		_NODISCARD bool probe(TProbeRange & range, const TIdSelection & id_selection, const TGroups & groups)
+		{
+			if (groups.group_count() == 0)
+				return false;
+
+			while (range.move_next())
 			{
-				const auto value = this->lhs_range.get_value();
-				const auto key   = this->lhs_id_selection(value);
-				this->current    = this->map.find(key);
+				const size_type group = groups.find(id_selection(range.get_value()));
 
-				if(this->current != this->map.end())
+				if (group != TGroups::npos)
 				{
+					this->position = groups.begin(group);
+					this->end      = groups.end(group);
 					return true;
 				}
 			}
 
 			return false;
 		}
-	
+
 	private:
 
 		/// <summary>
 		/// Member attributes
 		/// </summary>
-		
+
 		lhs_range_type        lhs_range;
 		rhs_range_type        rhs_range;
 		lhs_id_selection_type lhs_id_selection;
 		rhs_id_selection_type rhs_id_selection;
 		join_selection_type   join_selection;
-		
-		bool              start;
-		map_type          map;
-		map_iterator_type current;
-		
+		join_build_side       build_side;
+
+		bool            start;
+		lhs_groups_type lhs_groups;
+		rhs_groups_type rhs_groups;
+		size_type       position;
+		size_type       end;
+
 	};
-	
+
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/hash_groups.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Left outer hash join: yields every lhs value combined with each of
+	/// its matching rhs values, or once with a null pointer if there is
+	/// no match. The rhs gets loaded into hash groups, the lhs is streamed,
+	/// so the results follow the order of the lhs. Matches are passed as
+	/// pointers into the groups, so they never get copied.
+	/// </summary>
+	template<
+		range_concept TRange,
+		typename TEnumerable,
+		typename TLhsIdSelection,
+		typename TRhsIdSelection,
+		typename TJoinSelection
+	>
+	class left_join_range
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using enumerable            = std::remove_cvref_t<TEnumerable>;
+		using lhs_range_type        = std::remove_cvref_t<TRange>;
+		using rhs_range_type        = typename enumerable::range_type;
+		using lhs_id_selection_type = std::remove_cvref_t<TLhsIdSelection>;
+		using rhs_id_selection_type = std::remove_cvref_t<TRhsIdSelection>;
+		using join_selection_type   = std::remove_cvref_t<TJoinSelection>;
+		using lhs_value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using rhs_value_type        = std::remove_cvref_t<typename rhs_range_type::value_type>;
+		using rhs_id_type           = std::remove_cvref_t<std::invoke_result_t<rhs_id_selection_type, rhs_value_type>>;
+		using rhs_groups_type       = hash_groups<rhs_id_type, rhs_value_type>;
+		using join_result           = std::invoke_result_t<join_selection_type, lhs_value_type, const rhs_value_type *>;
+		using size_type             = std::size_t;
+
+		using value_type  = join_result;
+		using return_type = value_type;
+
+		static_assert(std::is_invocable_v<TLhsIdSelection, typename TRange::value_type>, "TLhsIdSelection (left_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TRhsIdSelection, typename TEnumerable::range_type::value_type>, "TRhsIdSelection (left_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TJoinSelection, typename TRange::value_type, const rhs_value_type *>, "TJoinSelection (left_join_range) has an invalid format!");
+
+	public:
+
+		_NODISCARD_CTOR explicit left_join_range(
+			const lhs_range_type & lhs_range,
+			const rhs_range_type & rhs_range,
+			const lhs_id_selection_type & lhs_id_selection,
+			const rhs_id_selection_type & rhs_id_selection,
+			const join_selection_type & join_selection
+		) : lhs_range(lhs_range),
+			rhs_range(rhs_range),
+			lhs_id_selection(lhs_id_selection),
+			rhs_id_selection(rhs_id_selection),
+			join_selection(join_selection),
+			start(true),
+			rhs_groups(),
+			position(0),
+			end(0)
+		{
+		}
+
+		_NODISCARD return_type get_value() const
+		{
+			if (this->position == this->end)
+				return this->join_selection(this->lhs_range.get_value(), static_cast<const rhs_value_type *>(nullptr));
+
+			return this->join_selection(this->lhs_range.get_value(), &this->rhs_groups[this->position]);
+		}
+
+		_NODISCARD bool move_next()
+		{
+			if (this->start)
+			{
+				this->start = false;
+				this->rhs_groups = make_hash_groups<rhs_groups_type>(this->rhs_range, this->rhs_id_selection);
+			}
+
+			// the remaining matches of the current lhs value come first
+			if (this->position + 1 < this->end)
+			{
+				++this->position;
+				return true;
+			}
+
+			if (!this->lhs_range.move_next())
+				return false;
+
+			const size_type group = this->rhs_groups.find(this->lhs_id_selection(this->lhs_range.get_value()));
+
+			// an unmatched value is yielded once, marked by an empty slice
+			if (group == rhs_groups_type::npos)
+			{
+				this->position = 0;
+				this->end      = 0;
+			}
+			else
+			{
+				this->position = this->rhs_groups.begin(group);
+				this->end      = this->rhs_groups.end(group);
+			}
+
+			return true;
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		lhs_range_type        lhs_range;
+		rhs_range_type        rhs_range;
+		lhs_id_selection_type lhs_id_selection;
+		rhs_id_selection_type rhs_id_selection;
+		join_selection_type   join_selection;
+
+		bool            start;
+		rhs_groups_type rhs_groups;
+		size_type       position;
+		size_type       end;
+
+	};
+
+}
\ No newline at end of file
@@ -1,53 +1,61 @@
 #pragma once
 
 #include <list>
-#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <stdexcept>
 
 #include <linq/utils/concepts.hpp>
+#include <linq/utils/hash_groups.hpp>
 
 #include <linq/enumerable.hpp>
 
 namespace linq
 {
 
+	/// @brief Range over the groups of a lookup, in the order their keys were seen first.
+	/// The values are stored in one contiguous array, group by group (see hash_groups),
+	/// which copies of the range share instead of duplicating.
+	/// Unlike the former std::map based lookup, the keys are not sorted and every group
+	/// is a hash_group_view instead of a std::list (see the breaking changes in the README)
+	/// @tparam TKey The key-type of the lookup structure
+	/// @tparam TValue The value-type of the lookup structure
 	template<typename TKey, typename TValue>
 	class outer_lookup_range
 	{
 		
 	public:
 
-		using key_type          = TKey;
-		using values_type       = std::list<TValue>;
-		using map_type          = std::map<key_type, values_type>;
-		using map_iterator_type = typename map_type::const_iterator;
-		using value_type        = typename map_type::value_type;
-		using return_type       = value_type;
+		using key_type    = std::remove_cvref_t<TKey>;
+		using values_type = std::list<TValue>;
+		using groups_type = hash_groups<key_type, std::remove_cvref_t<TValue>>;
+		using group_type  = hash_group_view<groups_type>;
+		using size_type   = typename groups_type::size_type;
+		using value_type  = std::pair<key_type, group_type>;
+		using return_type = value_type;
 
 	public:
 		
 		template<range_concept TRange, typename TKeySelector>
 		_NODISCARD outer_lookup_range(TRange range, TKeySelector selector)
-			: map(), iterator(), start(true)
+			: groups(std::make_shared<const groups_type>(make_hash_groups<groups_type>(range, selector))), group(0), start(true)
 		{
-			// go through the range
-			while (range.move_next())
-			{
-				// get the value
-				const TValue value = range.get_value();
-
-				// extract the key-value using the selector function
-				const TKey   key = selector(value);
+		}
 
-				// insert the pair into the map
-				this->map[key].push_back(value);
-			}
+		/// @brief builds the groups on multiple threads, with the same result as the sequential build
+		/// 
+		template<range_concept TRange, typename TKeySelector>
+		_NODISCARD outer_lookup_range(TRange range, TKeySelector selector, const parallel_policy & policy)
+			: groups(std::make_shared<const groups_type>(make_hash_groups<groups_type>(range, selector, policy))), group(0), start(true)
+		{
 		}
 		
-		/// @brief returns the current value
+		/// @brief returns the current key together with a view of its values
 		/// 
 		_NODISCARD return_type get_value() const
 		{
-			return *this->iterator;
+			return value_type(this->groups->key(this->group), group_type(this->groups, this->group));
 		}
 
 		/// @brief Increments the iterator and returns true if there is an element to process
@@ -56,19 +64,39 @@ namespace linq
 		{
 			if (this->start)
 			{
-				this->iterator = this->map.begin();
+				this->group = 0;
 				this->start = false;
 			} else
 			{
-				++this->iterator;
+				++this->group;
 			}
 
-			return this->iterator != this->map.end();
+			return this->group < this->groups->group_count();
+		}
+
+		/// @brief returns a view of the values of a key, which is empty if the key is unknown
+		/// @param key the key to look for
+		_NODISCARD group_type find(const key_type & key) const
+		{
+			return group_type(this->groups, this->groups->find(key));
+		}
+
+		/// @brief checks whether the lookup holds values for a key
+		/// @param key the key to look for
+		_NODISCARD bool contains(const key_type & key) const
+		{
+			return this->groups->find(key) != groups_type::npos;
 		}
 
+		/// @brief returns a copy of the values of a key
+		/// @throws std::out_of_range if the key is unknown
 		_NODISCARD values_type get_values_for_key(key_type key) const
 		{
-			return this->map.at(key);
+			const size_type found = this->groups->find(key);
+			if (found == groups_type::npos)
+				throw std::out_of_range("linq::lookup: unknown key");
+
+			return values_type(this->groups->data() + this->groups->begin(found), this->groups->data() + this->groups->end(found));
 		}
 	
 	private:
@@ -76,55 +104,66 @@ namespace linq
 		/// @brief Member attributes
 		/// 
 
-		map_type          map;
-		map_iterator_type iterator;
-		bool              start;
+		std::shared_ptr<const groups_type> groups;
+		size_type                          group;
+		bool                               start;
 
 		
 	};
 
+	/// @brief Range over the values of one key of a lookup. It only views the values
+	/// stored inside the lookup, which it shares ownership of, so nothing gets copied
+	/// @tparam TKey The key-type of the lookup structure
+	/// @tparam TValue The value-type of the lookup structure
 	template<typename TKey, typename TValue>
 	class inner_lookup_range
 	{
 	public:
 
-		using key_type        = TKey;
-		using value_type      = TValue;
-		using values_type     = std::list<value_type>;
-		using iterator_type   = typename values_type::const_iterator;
+		using key_type        = typename outer_lookup_range<TKey, TValue>::key_type;
+		using group_type      = typename outer_lookup_range<TKey, TValue>::group_type;
+		using size_type       = typename group_type::size_type;
+		using value_type      = typename group_type::value_type;
 		using return_type     = const value_type &;
 
 	public:
 
-		_NODISCARD_CTOR inner_lookup_range(values_type values)
-			: values(std::move(values)), iterator(), start(true)
+		_NODISCARD_CTOR inner_lookup_range(group_type group)
+			: group(std::move(group)), position(0), start(true)
 		{
 			
 		}
 
 		_NODISCARD return_type get_value() const
 		{
-			return *this->iterator;
+			return this->group[this->position];
 		}
 
 		_NODISCARD bool move_next()
 		{
 			if (this->start)
 			{
-				this->iterator = this->values.begin();
+				this->position = 0;
 				this->start = false;
 			} else
 			{
-				++this->iterator;
+				++this->position;
 			}
 
-			return this->iterator != this->values.end();
+			return this->position < this->group.size();
+		}
+
+		/// @brief returns the number of values of the key
+		/// 
+		_NODISCARD size_type size_hint() const
+		{
+			return this->group.size();
 		}
 	
 	private:
 
-		values_type     values;
-		iterator_type   iterator;
+		group_type      group;
+		size_type       position;
 		bool            start;
 		
 	};
@@ -135,6 +174,10 @@ namespace linq
 	template<typename TKey, typename TValue>
 	class lookup : public enumerable<outer_lookup_range<TKey, TValue>>
 	{
+	public:
+
+		using key_type = typename outer_lookup_range<TKey, TValue>::key_type;
+
 	public:
 
 		/// @brief Constructs a lookup
@@ -147,11 +190,45 @@ namespace linq
 			: enumerable<outer_lookup_range<TKey, TValue>>(outer_lookup_range<TKey, TValue>(range, selector))
 		{}
 
-		_NODISCARD enumerable<inner_lookup_range<TKey, TValue>> operator [] (TKey key) const
+		/// @brief Constructs a lookup on multiple threads, the key selector gets invoked concurrently
+		/// @tparam TRange the range-type
+		/// @tparam TKeySelector the function-type for key selection
+		/// @param range range instance
+		/// @param selector key-selector instance
+		/// @param policy the parallel policy to respect
+		template<range_concept TRange, typename TKeySelector>
+		_NODISCARD lookup(TRange range, TKeySelector selector, const parallel_policy & policy)
+			: enumerable<outer_lookup_range<TKey, TValue>>(outer_lookup_range<TKey, TValue>(range, selector, policy))
+		{}
+
+		/// @brief Returns the values of a key without copying them
+		/// @param key the key to look for
+		/// @throws std::out_of_range if the key is unknown
+		_NODISCARD enumerable<inner_lookup_range<TKey, TValue>> operator [] (const key_type & key) const
+		{
+			auto values = this->try_get(key);
+			if (!values)
+				throw std::out_of_range("linq::lookup: unknown key");
+
+			return *values;
+		}
+
+		/// @brief Returns the values of a key without copying them, or nothing if the key is unknown
+		/// @param key the key to look for
+		_NODISCARD std::optional<enumerable<inner_lookup_range<TKey, TValue>>> try_get(const key_type & key) const
+		{
+			auto group = this->get_range().find(key);
+			if (group.empty())
+				return std::nullopt;
+
+			return enumerable<inner_lookup_range<TKey, TValue>>(inner_lookup_range<TKey, TValue>(std::move(group)));
+		}
+
+		/// @brief Checks whether the lookup holds values for a key
+		/// @param key the key to look for
+		_NODISCARD bool contains(const key_type & key) const
 		{
-			const auto collection = this->get_range().get_values_for_key(key);
-			auto range = inner_lookup_range<TKey, TValue>(collection);
-			return enumerable<inner_lookup_range<TKey, TValue>>(range);
+			return this->get_range().contains(key);
 		}
 		
 	};
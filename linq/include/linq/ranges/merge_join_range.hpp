@@ -0,0 +1,176 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+
+#include <linq/utils/concepts.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Inner join of two ranges sorted by their ids. Both ranges are streamed
+	/// side by side, only the rhs values sharing the current id are buffered,
+	/// so inputs of any size can be joined with bounded memory. The results
+	/// follow the order of the lhs, matches of one lhs value the order of
+	/// the rhs.
+	/// </summary>
+	template<
+		range_concept TRange,
+		typename TEnumerable,
+		typename TLhsIdSelection,
+		typename TRhsIdSelection,
+		typename TJoinSelection,
+		typename TCompare
+	>
+	class merge_join_range
+	{
+	public:
+
+		static_assert(std::is_invocable_v<TLhsIdSelection, typename TRange::value_type>, "TLhsIdSelection (merge_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TRhsIdSelection, typename TEnumerable::range_type::value_type>, "TRhsIdSelection (merge_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TJoinSelection, typename TRange::value_type, typename TEnumerable::range_type::value_type>, "TJoinSelection (merge_join_range) has an invalid format!");
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using enumerable            = std::remove_cvref_t<TEnumerable>;
+		using lhs_range_type        = std::remove_cvref_t<TRange>;
+		using rhs_range_type        = typename enumerable::range_type;
+		using lhs_id_selection_type = std::remove_cvref_t<TLhsIdSelection>;
+		using rhs_id_selection_type = std::remove_cvref_t<TRhsIdSelection>;
+		using join_selection_type   = std::remove_cvref_t<TJoinSelection>;
+		using compare_type          = std::remove_cvref_t<TCompare>;
+		using lhs_value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using rhs_value_type        = std::remove_cvref_t<typename rhs_range_type::value_type>;
+		using rhs_id_type           = std::remove_cvref_t<std::invoke_result_t<rhs_id_selection_type, rhs_value_type>>;
+		using join_result           = std::invoke_result_t<join_selection_type, lhs_value_type, rhs_value_type>;
+		using size_type             = std::size_t;
+
+		using value_type  = join_result;
+		using return_type = value_type;
+
+	public:
+
+		/// <summary>
+		/// Creates a merge_join_range
+		/// </summary>
+		/// <param name="lhs_range">the lhs, sorted by its ids</param>
+		/// <param name="rhs_range">the rhs, sorted by its ids</param>
+		/// <param name="lhs_id_selection">function to select the id of an lhs value</param>
+		/// <param name="rhs_id_selection">function to select the id of an rhs value</param>
+		/// <param name="join_selection">function to combine two matching values</param>
+		/// <param name="compare">the strict weak ordering both ranges are sorted by, comparing ids of either side</param>
+		_NODISCARD_CTOR explicit merge_join_range(
+			const lhs_range_type & lhs_range,
+			const rhs_range_type & rhs_range,
+			const lhs_id_selection_type & lhs_id_selection,
+			const rhs_id_selection_type & rhs_id_selection,
+			const join_selection_type & join_selection,
+			const compare_type & compare
+		) : lhs_range(lhs_range),
+			rhs_range(rhs_range),
+			lhs_id_selection(lhs_id_selection),
+			rhs_id_selection(rhs_id_selection),
+			join_selection(join_selection),
+			compare(compare),
+			start(true),
+			has_rhs(false),
+			group(),
+			group_id(),
+			position(0)
+		{
+		}
+
+		_NODISCARD return_type get_value() const
+		{
+			return this->join_selection(this->lhs_range.get_value(), this->group[this->position]);
+		}
+
+		_NODISCARD bool move_next()
+		{
+			if (this->start)
+			{
+				this->start   = false;
+				this->has_rhs = this->rhs_range.move_next();
+			}
+			else if (this->position + 1 < this->group.size())
+			{
+				++this->position;
+				return true;
+			}
+
+			while (this->lhs_range.move_next())
+			{
+				const auto id = this->lhs_id_selection(this->lhs_range.get_value());
+
+				// the buffered group is still ahead of this id
+				if (this->group_id && this->compare(id, *this->group_id))
+					continue;
+
+				// consecutive lhs values with the same id reuse the group
+				if (this->group_id && !this->compare(*this->group_id, id))
+				{
+					this->position = 0;
+					return true;
+				}
+
+				while (this->has_rhs && this->compare(this->rhs_id_selection(this->rhs_range.get_value()), id))
+					this->has_rhs = this->rhs_range.move_next();
+
+				// every rhs id is smaller, nothing later can match either
+				if (!this->has_rhs)
+					return false;
+
+				this->load_group();
+
+				if (!this->compare(id, *this->group_id))
+				{
+					this->position = 0;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+	private:
+
+		/// <summary>
+		/// Buffers all rhs values sharing the id of the current rhs value
+		/// </summary>
+		void load_group()
+		{
+			this->group.clear();
+			this->group_id = this->rhs_id_selection(this->rhs_range.get_value());
+
+			do
+			{
+				this->group.push_back(this->rhs_range.get_value());
+				this->has_rhs = this->rhs_range.move_next();
+			}
+			while (this->has_rhs && !this->compare(*this->group_id, this->rhs_id_selection(this->rhs_range.get_value())));
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		lhs_range_type        lhs_range;
+		rhs_range_type        rhs_range;
+		lhs_id_selection_type lhs_id_selection;
+		rhs_id_selection_type rhs_id_selection;
+		join_selection_type   join_selection;
+		compare_type          compare;
+
+		bool                        start;
+		bool                        has_rhs;
+		std::vector<rhs_value_type> group;
+		std::optional<rhs_id_type>  group_id;
+		size_type                   position;
+
+	};
+
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <list>
+#include <tuple>
 
 #include <linq/ranges/sorting_range.hpp>
 
@@ -10,12 +10,16 @@ namespace linq
 {
 
 	template<range_concept TRange, typename TSelector>
-	class orderby_range : public sorting_range<typename TRange::value_type>
+	class orderby_range : public sorting_range<
+		orderby_range<TRange, TSelector>,
+		typename TRange::value_type,
+		std::tuple<std::remove_cvref_t<std::invoke_result_t<TSelector, typename TRange::value_type>>>
+	>
 	{
 	public:
 
 		static_assert(std::is_invocable_v<TSelector, typename TRange::value_type>, "typeparam TSelector (orderby_range) has an invalid format");
-		
+
 		/// <summary>
 		/// Type definitions
 		/// </summary>
@@ -24,8 +28,8 @@ namespace linq
 		using forward_return_type = typename range_type::return_type;
 		using value_type          = typename range_type::value_type;
 		using return_type         = const value_type &;
-		using list_type           = std::list<value_type>;
-		using list_iterator_type  = typename list_type::const_iterator;
+		using key_type            = std::tuple<std::remove_cvref_t<std::invoke_result_t<selector_type, value_type>>>;
+		using sorting_range_type  = sorting_range<orderby_range, value_type, key_type>;
 
 	public:
 
@@ -35,11 +39,13 @@ namespace linq
 		/// <param name="range">the range to sort</param>
 		/// <param name="selector">function to select a certain value of the value_type</param>
 		/// <param name="ascending">a boolean to indicate the sorting-direction</param>
+		/// <param name="options">the options deciding how the range gets sorted</param>
 		_NODISCARD_CTOR explicit orderby_range(
 			const range_type & range,
 			const selector_type & selector,
-			const bool ascending
-		) : range(range), selector(selector), ascending(ascending), values(), iterator()
+			const bool ascending,
+			const sort_options & options = sort_options()
+		) : sorting_range_type({ ascending }, options), range(range), selector(selector)
 		{}
 
 		_NODISCARD forward_return_type forward_get_value() const
@@ -53,53 +59,19 @@ namespace linq
 		}
 
 		/// <summary>
-		/// Returns the current value
-		/// </summary>
-		_NODISCARD return_type get_value() const
-		{
-			return *this->iterator;
-		}
-
-		/// <summary>
-		/// Moves to the next element in the range
+		/// Extracts the key a value gets sorted by
 		/// </summary>
-		_NODISCARD bool move_next()
+		/// <param name="value">the value to extract the key from</param>
+		_NODISCARD key_type select_key(const value_type & value) const
 		{
-			if(this->values.empty())
-			{
-				while (this->range.move_next())
-					this->values.push_back(this->range.get_value());
-
-				this->values.sort([this](const value_type & lhs, const value_type & rhs)
-				{
-					return this->compare_values(lhs, rhs);
-				});
-
-				this->iterator = this->values.begin();
-			} else
-			{
-				++this->iterator;
-			}
-			
-			return this->iterator != this->values.end();
+			return key_type(this->selector(value));
 		}
 
-		virtual bool compare_values(const value_type & lhs, const value_type & rhs) const override
-		{
-			if (this->ascending)
-				return this->selector(lhs) < this->selector(rhs);
-
-			return this->selector(rhs) < this->selector(lhs);
-		}
-	
 	private:
 
-		range_type         range;
-		selector_type      selector;
-		bool               ascending;
-		list_type          values;
-		list_iterator_type iterator;
-		
+		range_type    range;
+		selector_type selector;
+
 	};
-	
+
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <set>
+
+#include <linq/utils/concepts.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Removes duplicates through a std::set, used for value types
+	/// which can be ordered but not hashed
+	/// </summary>
+	template<range_concept TRange>
+	class ordered_distinct_range
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using range_type        = std::remove_cvref_t<TRange>;
+		using value_type        = std::remove_cvref_t<typename range_type::value_type>;
+		using return_type       = const value_type &;
+		using set_type          = std::set<value_type>;
+		using set_iterator_type = typename set_type::const_iterator;
+
+	public:
+
+		/// <summary>
+		/// Creates an ordered_distinct_range
+		/// </summary>
+		/// <param name="range">the range to operate on</param>
+		_NODISCARD_CTOR explicit ordered_distinct_range(const range_type & range)
+			: range(range), values(), iterator()
+		{
+		}
+
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			return *this->iterator;
+		}
+
+		/// <summary>
+		/// Increments the iterator to get the next value as
+		/// active one
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			while (this->range.move_next())
+			{
+				const auto insertionResult = this->values.insert(this->range.get_value());
+				if(insertionResult.second)
+				{
+					this->iterator = insertionResult.first;
+					return true;
+				}
+			}
+
+			this->values.clear();
+			return false;
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		range_type        range;
+		set_type          values;
+		set_iterator_type iterator;
+
+	};
+
+}
\ No newline at end of file
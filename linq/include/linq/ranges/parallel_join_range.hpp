@@ -0,0 +1,323 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/parallel.hpp>
+#include <linq/utils/hash_groups.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Inner hash join running on multiple threads. Both sides get loaded
+	/// and radix partitioned by the hash of their ids, so every partition
+	/// can be built and probed on its own thread with a table small enough
+	/// to stay in cache.
+	///
+	/// Only the matches are computed in parallel, the results are yielded
+	/// as one sequence in the same order the sequential join produces:
+	/// lhs order, the matches of a value in rhs order.
+	///
+	/// The id selections are invoked concurrently while hashing, partitioning
+	/// and probing, so they have to be thread-safe. The join selection is only
+	/// invoked by get_value, on the thread consuming the range.
+	/// </summary>
+	template<
+		range_concept TRange,
+		typename TEnumerable,
+		typename TLhsIdSelection,
+		typename TRhsIdSelection,
+		typename TJoinSelection
+	>
+	class parallel_join_range
+	{
+	public:
+
+		static_assert(std::is_invocable_v<TLhsIdSelection, typename TRange::value_type>, "TLhsIdSelection (parallel_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TRhsIdSelection, typename TEnumerable::range_type::value_type>, "TRhsIdSelection (parallel_join_range) has an invalid format!");
+		static_assert(std::is_invocable_v<TJoinSelection, typename TRange::value_type, typename TEnumerable::range_type::value_type>, "TJoinSelection (parallel_join_range) has an invalid format!");
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using enumerable            = std::remove_cvref_t<TEnumerable>;
+		using lhs_range_type        = std::remove_cvref_t<TRange>;
+		using rhs_range_type        = typename enumerable::range_type;
+		using lhs_id_selection_type = std::remove_cvref_t<TLhsIdSelection>;
+		using rhs_id_selection_type = std::remove_cvref_t<TRhsIdSelection>;
+		using join_selection_type   = std::remove_cvref_t<TJoinSelection>;
+		using lhs_value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using rhs_value_type        = std::remove_cvref_t<typename rhs_range_type::value_type>;
+		using rhs_id_type           = std::remove_cvref_t<std::invoke_result_t<rhs_id_selection_type, rhs_value_type>>;
+		using key_set_type          = flat_hash_set<rhs_id_type>;
+		using groups_type           = hash_groups<rhs_id_type, std::size_t, key_set_type>;
+		using join_result           = std::invoke_result_t<join_selection_type, lhs_value_type, rhs_value_type>;
+		using size_type             = std::size_t;
+
+		using value_type  = join_result;
+		using return_type = value_type;
+
+		static_assert(hashable_concept<rhs_id_type>, "rhs_id_type (parallel_join_range) has to be hashable!");
+
+	public:
+
+		_NODISCARD_CTOR explicit parallel_join_range(
+			const lhs_range_type & lhs_range,
+			const rhs_range_type & rhs_range,
+			const lhs_id_selection_type & lhs_id_selection,
+			const rhs_id_selection_type & rhs_id_selection,
+			const join_selection_type & join_selection,
+			const parallel_policy & policy
+		) : lhs_range(lhs_range),
+			rhs_range(rhs_range),
+			lhs_id_selection(lhs_id_selection),
+			rhs_id_selection(rhs_id_selection),
+			join_selection(join_selection),
+			policy(policy),
+			start(true),
+			lhs_values(),
+			rhs_values(),
+			lhs_hashes(),
+			lhs_groups(),
+			partitions(),
+			partition_shift(0),
+			current(0),
+			position(0),
+			end(0)
+		{
+		}
+
+		_NODISCARD return_type get_value() const
+		{
+			const groups_type & groups = this->partitions[this->partition_of(this->lhs_hashes[this->current])];
+			return this->join_selection(this->lhs_values[this->current], this->rhs_values[groups[this->position]]);
+		}
+
+		_NODISCARD bool move_next()
+		{
+			if (this->start)
+			{
+				this->start = false;
+				this->build_and_probe();
+
+				// the increment below moves onto the first lhs value
+				this->current = size_type(-1);
+			}
+
+			// the remaining matches of the current lhs value come first
+			if (this->position + 1 < this->end)
+			{
+				++this->position;
+				return true;
+			}
+
+			while (++this->current < this->lhs_values.size())
+			{
+				const size_type group = this->lhs_groups[this->current];
+
+				if (group != groups_type::npos)
+				{
+					const groups_type & groups = this->partitions[this->partition_of(this->lhs_hashes[this->current])];
+
+					this->position = groups.begin(group);
+					this->end      = groups.end(group);
+					return true;
+				}
+			}
+
+			this->current = this->lhs_values.size();
+			return false;
+		}
+
+	private:
+
+		/// <summary>
+		/// Positions of the values of one side, grouped by partition.
+		/// A single partition leaves the order empty, meaning identity.
+		/// </summary>
+		struct partitioning
+		{
+			std::vector<size_type> offsets;
+			std::vector<size_type> order;
+
+			_NODISCARD size_type operator [] (const size_type slot) const
+			{
+				return this->order.empty() ? slot : this->order[slot];
+			}
+		};
+
+		/// <summary>
+		/// Loads both sides, partitions them and finds the group of
+		/// matches of every lhs value
+		/// </summary>
+		void build_and_probe()
+		{
+			load(this->lhs_range, this->lhs_values);
+			load(this->rhs_range, this->rhs_values);
+
+			const size_type threads = this->policy.threads_for(this->lhs_values.size() + this->rhs_values.size());
+
+			// a few partitions per thread balance skewed keys, a single one is a plain hash join
+			unsigned bits = 0;
+			if (threads > 1)
+			{
+				while ((size_type(1) << bits) < threads * 8)
+					++bits;
+			}
+
+			const size_type partition_count = size_type(1) << bits;
+			this->partition_shift = std::numeric_limits<std::uint64_t>::digits - bits;
+			this->partitions.assign(partition_count, groups_type());
+
+			const typename key_set_type::hasher_type hash;
+
+			std::vector<size_type> rhs_hashes(this->rhs_values.size());
+			parallel_for(threads, threads, [&](const size_type chunk)
+			{
+				for (size_type index = this->rhs_values.size() * chunk / threads; index < this->rhs_values.size() * (chunk + 1) / threads; ++index)
+					rhs_hashes[index] = hash(this->rhs_id_selection(this->rhs_values[index]));
+			});
+
+			this->lhs_hashes.resize(this->lhs_values.size());
+			parallel_for(threads, threads, [&](const size_type chunk)
+			{
+				for (size_type index = this->lhs_values.size() * chunk / threads; index < this->lhs_values.size() * (chunk + 1) / threads; ++index)
+					this->lhs_hashes[index] = hash(static_cast<rhs_id_type>(this->lhs_id_selection(this->lhs_values[index])));
+			});
+
+			const partitioning rhs_parts = this->partition(rhs_hashes, partition_count, threads);
+			const partitioning lhs_parts = this->partition(this->lhs_hashes, partition_count, threads);
+
+			this->lhs_groups.assign(this->lhs_values.size(), groups_type::npos);
+
+			parallel_for(threads, partition_count, [&](const size_type part)
+			{
+				groups_type & groups = this->partitions[part];
+				groups.reserve(rhs_parts.offsets[part + 1] - rhs_parts.offsets[part]);
+
+				// the positions are ascending inside a partition, so the groups keep the rhs order
+				for (size_type slot = rhs_parts.offsets[part]; slot < rhs_parts.offsets[part + 1]; ++slot)
+				{
+					const size_type index = rhs_parts[slot];
+					groups.add(this->rhs_id_selection(this->rhs_values[index]), index, rhs_hashes[index]);
+				}
+
+				groups.build();
+
+				if (groups.group_count() == 0)
+					return;
+
+				for (size_type slot = lhs_parts.offsets[part]; slot < lhs_parts.offsets[part + 1]; ++slot)
+				{
+					const size_type index = lhs_parts[slot];
+					this->lhs_groups[index] = groups.find(static_cast<rhs_id_type>(this->lhs_id_selection(this->lhs_values[index])), this->lhs_hashes[index]);
+				}
+			});
+		}
+
+		/// <summary>
+		/// Scatters the positions of the hashes into their partitions. Every
+		/// thread counts and scatters its own chunk, so the positions stay
+		/// ascending inside each partition.
+		/// </summary>
+		_NODISCARD partitioning partition(const std::vector<size_type> & hashes, const size_type partition_count, const size_type threads) const
+		{
+			const size_type size = hashes.size();
+
+			if (partition_count == 1)
+				return partitioning{ std::vector<size_type>{ 0, size }, std::vector<size_type>() };
+
+			std::vector<size_type> counts(threads * partition_count, 0);
+
+			parallel_for(threads, threads, [&](const size_type chunk)
+			{
+				size_type * chunk_counts = counts.data() + chunk * partition_count;
+
+				for (size_type index = size * chunk / threads; index < size * (chunk + 1) / threads; ++index)
+					++chunk_counts[this->partition_of(hashes[index])];
+			});
+
+			// partition-major prefix sums give every chunk its slice of each partition
+			partitioning result{ std::vector<size_type>(partition_count + 1, 0), std::vector<size_type>(size) };
+
+			size_type total = 0;
+			for (size_type part = 0; part < partition_count; ++part)
+			{
+				result.offsets[part] = total;
+
+				for (size_type chunk = 0; chunk < threads; ++chunk)
+				{
+					const size_type count = counts[chunk * partition_count + part];
+					counts[chunk * partition_count + part] = total;
+					total += count;
+				}
+			}
+
+			result.offsets[partition_count] = total;
+
+			parallel_for(threads, threads, [&](const size_type chunk)
+			{
+				size_type * next = counts.data() + chunk * partition_count;
+
+				for (size_type index = size * chunk / threads; index < size * (chunk + 1) / threads; ++index)
+					result.order[next[this->partition_of(hashes[index])]++] = index;
+			});
+
+			return result;
+		}
+
+		/// <summary>
+		/// Selects the partition through the upper bits of a hash mixed differently
+		/// than the hash table does, so a partition still spreads over its whole table
+		/// </summary>
+		_NODISCARD size_type partition_of(const size_type hash) const
+		{
+			if (this->partition_shift == std::numeric_limits<std::uint64_t>::digits)
+				return 0;
+
+			return static_cast<size_type>((static_cast<std::uint64_t>(hash) * 0xD6E8FEB86659FD93ull) >> this->partition_shift);
+		}
+
+		/// <summary>
+		/// Copies all values of a range into a vector
+		/// </summary>
+		template<typename TLoadRange, typename TValue>
+		static void load(TLoadRange & range, std::vector<TValue> & values)
+		{
+			if constexpr (sized_range_concept<TLoadRange>)
+				values.reserve(range.size_hint());
+
+			while (range.move_next())
+				values.push_back(range.get_value());
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		lhs_range_type        lhs_range;
+		rhs_range_type        rhs_range;
+		lhs_id_selection_type lhs_id_selection;
+		rhs_id_selection_type rhs_id_selection;
+		join_selection_type   join_selection;
+		parallel_policy       policy;
+
+		bool                        start;
+		std::vector<lhs_value_type> lhs_values;
+		std::vector<rhs_value_type> rhs_values;
+		std::vector<size_type>      lhs_hashes;
+		std::vector<size_type>      lhs_groups;
+		std::vector<groups_type>    partitions;
+		unsigned                    partition_shift;
+		size_type                   current;
+		size_type                   position;
+		size_type                   end;
+
+	};
+
+}
\ No newline at end of file
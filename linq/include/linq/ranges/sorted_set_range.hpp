@@ -0,0 +1,190 @@
+#pragma once
+
+#include <linq/utils/concepts.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Set operations a sorted_set_range can perform
+	/// </summary>
+	enum class sorted_set_operation
+	{
+		intersection,
+		union_of,
+		difference
+	};
+
+	/// <summary>
+	/// Performs a set operation on two ranges sorted by the same ordering
+	/// through a single streaming merge. Only the last emitted value is
+	/// kept, so the memory needed is constant. Each value is emitted once
+	/// and the result is sorted as well.
+	/// </summary>
+	template<range_concept TLhsRange, range_concept TRhsRange, typename TCompare, sorted_set_operation Operation>
+	class sorted_set_range
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using lhs_range_type = std::remove_cvref_t<TLhsRange>;
+		using rhs_range_type = std::remove_cvref_t<TRhsRange>;
+		using compare_type   = std::remove_cvref_t<TCompare>;
+		using value_type     = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using return_type    = const value_type &;
+
+	public:
+
+		/// <summary>
+		/// Creates a sorted_set_range
+		/// </summary>
+		/// <param name="lhs_range">the left-hand-side range, sorted by compare</param>
+		/// <param name="rhs_range">the right-hand-side range, sorted by compare</param>
+		/// <param name="compare">the strict weak ordering both ranges are sorted by</param>
+		_NODISCARD_CTOR explicit sorted_set_range(
+			const lhs_range_type & lhs_range,
+			const rhs_range_type & rhs_range,
+			const compare_type & compare
+		) : lhs_range(lhs_range),
+			rhs_range(rhs_range),
+			compare(compare),
+			current(),
+			started(false),
+			emitted(false),
+			has_lhs(false),
+			has_rhs(false)
+		{
+		}
+
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			return this->current;
+		}
+
+		/// <summary>
+		/// Merges forward until the next value of the result
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			if (!this->started)
+			{
+				this->started = true;
+				this->has_lhs = this->lhs_range.move_next();
+				this->has_rhs = this->rhs_range.move_next();
+			}
+
+			if constexpr (Operation == sorted_set_operation::intersection)
+			{
+				while (this->has_lhs && this->has_rhs)
+				{
+					const auto & lhs = this->lhs_range.get_value();
+					const auto & rhs = this->rhs_range.get_value();
+
+					if (this->compare(lhs, rhs))
+					{
+						this->has_lhs = this->lhs_range.move_next();
+					}
+					else if (this->compare(rhs, lhs))
+					{
+						this->has_rhs = this->rhs_range.move_next();
+					}
+					else
+					{
+						const bool accepted = this->accept(lhs);
+						this->has_lhs = this->lhs_range.move_next();
+						this->has_rhs = this->rhs_range.move_next();
+
+						if (accepted)
+							return true;
+					}
+				}
+			}
+			else if constexpr (Operation == sorted_set_operation::union_of)
+			{
+				while (this->has_lhs || this->has_rhs)
+				{
+					bool accepted;
+
+					if (this->has_lhs && (!this->has_rhs || !this->compare(this->rhs_range.get_value(), this->lhs_range.get_value())))
+					{
+						accepted = this->accept(this->lhs_range.get_value());
+						this->has_lhs = this->lhs_range.move_next();
+					}
+					else
+					{
+						accepted = this->accept(this->rhs_range.get_value());
+						this->has_rhs = this->rhs_range.move_next();
+					}
+
+					if (accepted)
+						return true;
+				}
+			}
+			else
+			{
+				while (this->has_lhs)
+				{
+					const auto & lhs = this->lhs_range.get_value();
+
+					if (!this->has_rhs || this->compare(lhs, this->rhs_range.get_value()))
+					{
+						const bool accepted = this->accept(lhs);
+						this->has_lhs = this->lhs_range.move_next();
+
+						if (accepted)
+							return true;
+					}
+					else if (this->compare(this->rhs_range.get_value(), lhs))
+					{
+						this->has_rhs = this->rhs_range.move_next();
+					}
+					else
+					{
+						// the rhs value stays, the lhs may hold further duplicates of it
+						this->has_lhs = this->lhs_range.move_next();
+					}
+				}
+			}
+
+			return false;
+		}
+
+	private:
+
+		/// <summary>
+		/// Takes over a candidate unless it equals the last emitted value
+		/// </summary>
+		template<typename TValue>
+		_NODISCARD bool accept(const TValue & candidate)
+		{
+			if (this->emitted && !this->compare(this->current, candidate))
+				return false;
+
+			this->current = candidate;
+			this->emitted = true;
+			return true;
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		lhs_range_type lhs_range;
+		rhs_range_type rhs_range;
+		compare_type   compare;
+		value_type     current;
+		bool           started;
+		bool           emitted;
+		bool           has_lhs;
+		bool           has_rhs;
+
+	};
+
+}
\ No newline at end of file
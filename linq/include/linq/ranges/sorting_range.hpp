@@ -1,8 +1,97 @@
 #pragma once
 
+#include <tuple>
+#include <array>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <concepts>
+
+#include <linq/utils/sort_buffer.hpp>
+#include <linq/utils/parallel.hpp>
+#include <linq/utils/radix_sort.hpp>
+#include <linq/utils/string_sort.hpp>
+#include <linq/utils/external_sort.hpp>
+
 namespace linq
 {
-	template<typename TValue>
+
+	/// <summary>
+	/// Appends a key type to the key tuple of an ordering chain
+	/// </summary>
+	template<typename TKeyTuple, typename TKey>
+	struct append_sort_key;
+
+	template<typename... TKeys, typename TKey>
+	struct append_sort_key<std::tuple<TKeys...>, TKey>
+	{
+		using type = std::tuple<TKeys..., TKey>;
+	};
+
+	template<typename TKeyTuple, typename TKey>
+	using append_sort_key_t = typename append_sort_key<TKeyTuple, TKey>::type;
+
+	/// <summary>
+	/// Opt-in policy to sort lazily. The input gets turned into a heap in
+	/// O(n) and every further element costs O(log n), so consumers which stop
+	/// early skip most of the sorting work.
+	/// </summary>
+	struct incremental_sort_policy
+	{
+	};
+
+	/// <summary>
+	/// Default incremental sort policy
+	/// </summary>
+	inline constexpr incremental_sort_policy incremental{};
+
+	/// <summary>
+	/// All options an ordering chain gets sorted with
+	/// </summary>
+	struct sort_options
+	{
+		parallel_policy                     parallelism = sequential;
+		std::optional<external_sort_policy> external    = std::nullopt;
+		bool                                incremental = false;
+	};
+
+	/// <summary>
+	/// Converts the policies accepted by orderby into sort options
+	/// </summary>
+	_NODISCARD inline sort_options make_sort_options(const parallel_policy & policy)
+	{
+		return sort_options{ policy, std::nullopt, false };
+	}
+
+	_NODISCARD inline sort_options make_sort_options(const external_sort_policy & policy)
+	{
+		return sort_options{ sequential, policy, false };
+	}
+
+	_NODISCARD inline sort_options make_sort_options(const incremental_sort_policy &)
+	{
+		return sort_options{ sequential, std::nullopt, true };
+	}
+
+	/// <summary>
+	/// Policies orderby accepts
+	/// </summary>
+	template<typename TPolicy>
+	concept sort_policy_concept = requires(const TPolicy & policy)
+	{
+		{ make_sort_options(policy) } -> std::same_as<sort_options>;
+	};
+
+	/// <summary>
+	/// Shared sorting engine of orderby_range and thenby_range.
+	///
+	/// The whole ordering chain is described by a single tuple of keys
+	/// and one direction per key, so comparing two elements is one
+	/// lexicographic pass without virtual dispatch. The derived range
+	/// provides forward_move_next, forward_get_value and select_key.
+	/// </summary>
+	template<typename TDerived, typename TValue, typename TKey>
 	class sorting_range
 	{
 	public:
@@ -10,21 +99,407 @@ namespace linq
 		/// <summary>
 		/// Type definitions
 		/// </summary>
-		using value_type = TValue;
+		using value_type          = TValue;
+		using return_type         = const value_type &;
+		using key_type            = TKey;
+		using buffer_type         = sort_buffer<value_type, key_type>;
+		using size_type           = typename buffer_type::size_type;
+		using direction_list_type = std::array<bool, std::tuple_size_v<key_type>>;
+		using runs_type           = external_runs<value_type, key_type>;
+
+		inline static constexpr size_type key_count = std::tuple_size_v<key_type>;
 
 	public:
 
 		/// <summary>
-		/// Virtual destructor
+		/// Creates the sorting engine
 		/// </summary>
-		virtual ~sorting_range() = default;
+		/// <param name="directions">one flag per key, true meaning ascending</param>
+		/// <param name="options">the options deciding how the chain gets sorted</param>
+		_NODISCARD_CTOR explicit sorting_range(const direction_list_type & directions, const sort_options & options)
+			: directions(directions),
+			options(options),
+			limit(std::numeric_limits<size_type>::max()),
+			sorted(false),
+			values(),
+			position(0),
+			heap_size(0),
+			runs()
+		{
+		}
+
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
+		_NODISCARD return_type get_value() const
+		{
+			if constexpr (serializable_concept<value_type>)
+			{
+				if (this->runs)
+					return this->runs->get_value();
+			}
+
+			return this->values[this->position];
+		}
+
+		/// <summary>
+		/// Moves to the next element in the range
+		/// </summary>
+		_NODISCARD bool move_next()
+		{
+			if (!this->sorted)
+			{
+				this->sorted = true;
+
+				if (this->limit != std::numeric_limits<size_type>::max())
+				{
+					if (this->limit > 0)
+						this->sort_first();
+				}
+				else if (this->options.incremental && !this->options.external)
+				{
+					this->make_heap();
+				}
+				else
+				{
+					this->sort_all();
+				}
+
+				this->position = 0;
+			}
+			else if (!this->incremental_active())
+			{
+				++this->position;
+			}
+
+			if (this->incremental_active())
+			{
+				// the smallest remaining entry moves behind the shrinking heap
+				if (this->heap_size == 0)
+				{
+					this->position = this->values.size();
+					return false;
+				}
+
+				this->values.pop_heap(this->heap_size--, this->make_key_compare());
+				this->position = this->heap_size;
+				return true;
+			}
+
+			if constexpr (serializable_concept<value_type>)
+			{
+				// the values got spilled to disk, merge the sorted runs lazily
+				if (this->runs)
+					return this->runs->move_next(this->make_key_selector(), this->make_key_compare());
+			}
+
+			return this->position < this->values.size();
+		}
+
+		/// <summary>
+		/// Tells the range that at most count elements will be consumed.
+		/// Sorting then degrades to a top-k selection which needs
+		/// O(n log k) time and O(k) memory.
+		/// </summary>
+		/// <param name="count">the maximum number of elements to consume</param>
+		void limit_to(const size_type count)
+		{
+			this->limit = std::min(this->limit, count);
+		}
+
+		/// <summary>
+		/// Returns the element a full sort would put at rank without sorting
+		/// the range, runs in expected O(n). The range must not have been
+		/// iterated yet.
+		/// </summary>
+		/// <param name="rank">the zero-based position in sorted order</param>
+		/// <returns>the element, or nothing if the range holds fewer elements</returns>
+		_NODISCARD std::optional<value_type> select_nth(const size_type rank)
+		{
+			// spilled runs are merged sequentially anyway
+			if (this->options.external)
+			{
+				for (size_type current = 0; current <= rank; ++current)
+				{
+					if (!this->move_next())
+						return std::nullopt;
+				}
+
+				return this->get_value();
+			}
+
+			return this->select([rank](const size_type) { return rank; });
+		}
+
+		/// <summary>
+		/// Returns the element a full sort would put last without sorting
+		/// the range. The range must not have been iterated yet.
+		/// </summary>
+		/// <returns>the element, or nothing if the range is empty</returns>
+		_NODISCARD std::optional<value_type> select_last()
+		{
+			if (this->options.external)
+			{
+				std::optional<value_type> result;
+				while (this->move_next())
+					result = this->get_value();
+
+				return result;
+			}
+
+			return this->select([](const size_type size) { return size - 1; });
+		}
+
+		/// <summary>
+		/// Returns the lower median a full sort would produce without sorting
+		/// the range. The range must not have been iterated yet.
+		/// </summary>
+		/// <returns>the element, or nothing if the range is empty</returns>
+		_NODISCARD std::optional<value_type> select_median()
+		{
+			return this->select([](const size_type size) { return (size - 1) / 2; });
+		}
+
+		/// <summary>
+		/// Compares two previously extracted key chains against each other
+		/// </summary>
+		/// <param name="lhs">the left-hand-side</param>
+		/// <param name="rhs">the right-hand-side</param>
+		_NODISCARD bool compare_keys(const key_type & lhs, const key_type & rhs) const
+		{
+			return this->compare_keys_from<0>(lhs, rhs);
+		}
 
 		/// <summary>
 		/// Compares two values against each other
 		/// </summary>
 		/// <param name="lhs">the left-hand-side</param>
 		/// <param name="rhs">the right-hand-side</param>
-		virtual bool compare_values(const value_type & lhs, const value_type & rhs) const = 0;
-		
+		_NODISCARD bool compare_values(const value_type & lhs, const value_type & rhs) const
+		{
+			return this->compare_keys(this->derived().select_key(lhs), this->derived().select_key(rhs));
+		}
+
+		/// <summary>
+		/// Returns the sorting direction of each key
+		/// </summary>
+		_NODISCARD const direction_list_type & get_directions() const
+		{
+			return this->directions;
+		}
+
+		/// <summary>
+		/// Returns the options the chain gets sorted with
+		/// </summary>
+		_NODISCARD const sort_options & get_options() const
+		{
+			return this->options;
+		}
+
+	private:
+
+		/// <summary>
+		/// Materializes and sorts the whole input, spilling sorted runs
+		/// to disk whenever the memory budget of an external sort is exceeded
+		/// </summary>
+		void sort_all()
+		{
+			size_type buffered_bytes = 0;
+
+			// the key chains get extracted once the values are stored, see sort_values
+			while (this->derived().forward_move_next())
+			{
+				const value_type & value = this->derived().forward_get_value();
+				this->values.push_back(value);
+
+				if constexpr (serializable_concept<value_type>)
+				{
+					if (this->options.external)
+					{
+						buffered_bytes += serializer<value_type>::size(value) + sizeof(typename buffer_type::entry) + owned_heap_size(this->derived().select_key(value));
+
+						if (buffered_bytes >= this->options.external->memory_budget)
+						{
+							this->spill();
+							buffered_bytes = 0;
+						}
+					}
+				}
+			}
+
+			if constexpr (serializable_concept<value_type>)
+			{
+				if (this->runs)
+				{
+					this->spill();
+					this->runs->open(this->make_key_selector(), this->make_key_compare());
+					return;
+				}
+			}
+
+			this->sort_values();
+		}
+
+		/// <summary>
+		/// Materializes the input into a heap, the elements get extracted one by one
+		/// </summary>
+		void make_heap()
+		{
+			this->materialize();
+			this->values.make_heap(this->make_key_compare());
+			this->heap_size = this->values.size();
+		}
+
+		/// <summary>
+		/// Buffers the input and partitions it around a single rank
+		/// </summary>
+		/// <param name="rank_of">maps the number of buffered elements onto the rank to select</param>
+		template<typename TRankOf>
+		_NODISCARD std::optional<value_type> select(const TRankOf & rank_of)
+		{
+			this->materialize();
+			this->sorted = true;
+
+			const size_type size = this->values.size();
+			if (size == 0)
+				return std::nullopt;
+
+			const size_type rank = rank_of(size);
+			if (rank >= size)
+				return std::nullopt;
+
+			this->values.select(rank, this->make_key_compare());
+			return this->values[rank];
+		}
+
+		/// <summary>
+		/// Buffers every value of the input, the key chains get extracted from
+		/// the stored values once the input ends
+		/// </summary>
+		void materialize()
+		{
+			while (this->derived().forward_move_next())
+				this->values.push_back(this->derived().forward_get_value());
+
+			this->values.extract_keys(this->make_key_selector());
+		}
+
+		_NODISCARD bool incremental_active() const
+		{
+			return this->options.incremental && !this->options.external && this->limit == std::numeric_limits<size_type>::max();
+		}
+
+		/// <summary>
+		/// Only the first elements get consumed, keeps the best ones in a bounded heap
+		/// </summary>
+		void sort_first()
+		{
+			const auto compare = this->make_key_compare();
+
+			while (this->derived().forward_move_next())
+			{
+				const value_type & value = this->derived().forward_get_value();
+				this->values.push_bounded(value, this->make_key_selector(), this->limit, compare);
+			}
+
+			this->values.sort_bounded(compare);
+		}
+
+		/// <summary>
+		/// Sorts the buffered values with the fastest algorithm for the key type
+		/// </summary>
+		void sort_values()
+		{
+			const auto compare = this->make_key_compare();
+
+			this->values.extract_keys(this->make_key_selector());
+
+			// integral, floating-point and string keys are sorted without full key comparisons
+			if constexpr (is_radix_key_tuple_v<key_type>)
+				this->values.radix_sort(this->directions, compare, this->options.parallelism);
+			else if constexpr (is_string_key_tuple_v<key_type>)
+				this->values.string_sort(this->directions.front(), compare, this->options.parallelism);
+			else
+				this->values.sort(compare, this->options.parallelism);
+		}
+
+		/// <summary>
+		/// Sorts the buffered values and writes them to disk as a new run
+		/// </summary>
+		void spill()
+		{
+			this->sort_values();
+
+			if (!this->runs)
+				this->runs = std::make_shared<runs_type>(this->options.external->directory);
+
+			this->runs->write(this->values);
+			this->values.clear();
+		}
+
+		_NODISCARD auto make_key_compare() const
+		{
+			return [this](const key_type & lhs, const key_type & rhs)
+			{
+				return this->compare_keys(lhs, rhs);
+			};
+		}
+
+		_NODISCARD auto make_key_selector() const
+		{
+			return [this](const value_type & value)
+			{
+				return this->derived().select_key(value);
+			};
+		}
+
+		template<size_type Index>
+		_NODISCARD bool compare_keys_from(const key_type & lhs, const key_type & rhs) const
+		{
+			const auto & lhs_key = std::get<Index>(lhs);
+			const auto & rhs_key = std::get<Index>(rhs);
+
+			if constexpr (Index + 1 == key_count)
+			{
+				return this->directions[Index] ? lhs_key < rhs_key : rhs_key < lhs_key;
+			}
+			else
+			{
+				if (lhs_key < rhs_key)
+					return this->directions[Index];
+
+				if (rhs_key < lhs_key)
+					return !this->directions[Index];
+
+				return this->compare_keys_from<Index + 1>(lhs, rhs);
+			}
+		}
+
+		_NODISCARD TDerived & derived()
+		{
+			return static_cast<TDerived &>(*this);
+		}
+
+		_NODISCARD const TDerived & derived() const
+		{
+			return static_cast<const TDerived &>(*this);
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		direction_list_type        directions;
+		sort_options               options;
+		size_type                  limit;
+		bool                       sorted;
+		buffer_type                values;
+		size_type                  position;
+		size_type                  heap_size;
+		std::shared_ptr<runs_type> runs;
+
 	};
+
 }
\ No newline at end of file
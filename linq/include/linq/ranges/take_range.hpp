@@ -30,6 +30,9 @@ namespace linq
 		_NODISCARD_CTOR explicit take_range(const range_type & range, const size_type count)
 			: range(range), remaining(count)
 		{
+			// a sorted range only has to select the elements we are going to take
+			if constexpr (sorting_range_concept<range_type>)
+				this->range.limit_to(count);
 		}
 
 		/// <summary>
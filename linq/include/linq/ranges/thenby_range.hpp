@@ -1,6 +1,7 @@
 #pragma once
 
-#include <list>
+#include <tuple>
+#include <algorithm>
 
 #include <linq/ranges/sorting_range.hpp>
 
@@ -8,9 +9,13 @@
 
 namespace linq
 {
-	
+
 	template<sorting_range_concept TRange, typename TSelector>
-	class thenby_range : public sorting_range<typename TRange::value_type>
+	class thenby_range : public sorting_range<
+		thenby_range<TRange, TSelector>,
+		typename TRange::value_type,
+		append_sort_key_t<typename TRange::key_type, std::remove_cvref_t<std::invoke_result_t<TSelector, typename TRange::value_type>>>
+	>
 	{
 	public:
 
@@ -24,9 +29,9 @@ namespace linq
 		using value_type          = typename range_type::value_type;
 		using return_type         = const value_type &;
 		using forward_return_type = typename range_type::forward_return_type;
-		using list_type           = std::list<value_type>;
-		using list_iterator_type  = typename list_type::const_iterator;
-		
+		using own_key_type        = std::remove_cvref_t<std::invoke_result_t<selector_type, value_type>>;
+		using key_type            = append_sort_key_t<typename range_type::key_type, own_key_type>;
+		using sorting_range_type  = sorting_range<thenby_range, value_type, key_type>;
 
 	public:
 
@@ -40,79 +45,50 @@ namespace linq
 			const range_type & range,
 			const selector_type & selector,
 			const bool ascending
-		) : range(range), selector(selector), ascending(ascending), values()
+		) : sorting_range_type(append_direction(range, ascending), range.get_options()), range(range), selector(selector)
 		{
 		}
 
 		_NODISCARD forward_return_type forward_get_value() const
 		{
-			return this->range.get_value();
+			return this->range.forward_get_value();
 		}
 
 		_NODISCARD bool forward_move_next()
 		{
-			return this->range.move_next();
+			return this->range.forward_move_next();
 		}
 
 		/// <summary>
-		/// Returns the current value
+		/// Extracts the keys of the whole ordering chain
 		/// </summary>
-		_NODISCARD return_type get_value() const
+		/// <param name="value">the value to extract the keys from</param>
+		_NODISCARD key_type select_key(const value_type & value) const
 		{
-			return *this->iterator;
+			return std::tuple_cat(this->range.select_key(value), std::tuple<own_key_type>(this->selector(value)));
 		}
 
+	private:
+
 		/// <summary>
-		/// Moves to the next element in the range
+		/// Copies the directions of the parent chain and appends the own one
 		/// </summary>
-		_NODISCARD bool move_next()
+		_NODISCARD static typename sorting_range_type::direction_list_type append_direction(const range_type & range, const bool ascending)
 		{
-			if (this->values.empty())
-			{
-				while (this->range.forward_move_next())
-					this->values.push_back(this->range.forward_get_value());
-
-				this->values.sort([this](const value_type & lhs, const value_type & rhs)
-				{
-					return this->compare_values(lhs, rhs);
-				});
-
-				this->iterator = this->values.begin();
-			}
-			else
-			{
-				++this->iterator;
-			}
-			
-			return this->iterator != this->values.end();
-		}
+			typename sorting_range_type::direction_list_type directions{};
 
-		virtual bool compare_values(const value_type & lhs, const value_type & rhs) const override
-		{
-			if(this->range.compare_values(lhs, rhs))
-			{
-				return true;
-			}
-
-			if(this->range.compare_values(rhs, lhs))
-			{
-				return false;
-			}
-			
-			if (this->ascending)
-				return this->selector(lhs) < this->selector(rhs);
-
-			return this->selector(rhs) < this->selector(lhs);
+			const auto & parent_directions = range.get_directions();
+			std::copy(parent_directions.begin(), parent_directions.end(), directions.begin());
+			directions.back() = ascending;
+
+			return directions;
 		}
 
 	private:
 
-		range_type         range;
-		selector_type      selector;
-		bool               ascending;
-		list_type          values;
-		list_iterator_type iterator;
-		
+		range_type    range;
+		selector_type selector;
+
 	};
 
 }
\ No newline at end of file
@@ -2,69 +2,100 @@
 
 #include <linq/utils/concepts.hpp>
 
-#include <set>
-
 namespace linq
 {
 
-	template<range_concept TRange, typename TEnumerable>
+	/// <summary>
+	/// Yields the distinct values of both ranges, the lhs values first
+	/// and then the rhs values, each in the order they are seen first
+	/// </summary>
+	template<range_concept TRange, typename TEnumerable, typename TSet>
 	class union_range
 	{
 	public:
 
-		using enumerable        = std::remove_cvref_t<TEnumerable>;
-		using lhs_range_type    = std::remove_cvref_t<TRange>;
-		using rhs_range_type    = typename enumerable::range_type;
-		using value_type        = std::remove_cvref_t<typename lhs_range_type::value_type>;
-		using return_type       = const value_type &;
-		using set_type          = std::set<value_type>;
-		using set_iterator_type = typename set_type::const_iterator;
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using enumerable     = std::remove_cvref_t<TEnumerable>;
+		using lhs_range_type = std::remove_cvref_t<TRange>;
+		using rhs_range_type = typename enumerable::range_type;
+		using set_type       = std::remove_cvref_t<TSet>;
+		using value_type     = std::remove_cvref_t<typename lhs_range_type::value_type>;
+		using return_type    = const value_type &;
+		using size_type      = typename set_type::size_type;
 	
 	public:
 
+		/// <summary>
+		/// Creates a union_range
+		/// </summary>
+		/// <param name="lhs_range">the range whose values come first</param>
+		/// <param name="rhs_range">the range whose values come second</param>
+		/// <param name="values">an empty set carrying the hash function and equality to use</param>
 		_NODISCARD_CTOR explicit union_range(
 			const lhs_range_type & lhs_range,
-			const rhs_range_type & rhs_range
+			const rhs_range_type & rhs_range,
+			const set_type & values
 		)
-			: lhs_range(lhs_range), rhs_range(rhs_range), values(), iterator()
+			: lhs_range(lhs_range), rhs_range(rhs_range), values(values), position(0), lhs_done(false)
 		{}
 
+		/// <summary>
+		/// Returns the current value
+		/// </summary>
 		_NODISCARD return_type get_value() const
 		{
-			return *this->iterator;
+			return this->values[this->position];
 		}
 
+		/// <summary>
+		/// Moves to the next value not seen before
+		/// </summary>
 		_NODISCARD bool move_next()
 		{
-			while (this->rhs_range.move_next())
+			if (!this->lhs_done)
 			{
-				const auto insertionResult = this->values.insert(this->rhs_range.get_value());
-				if (insertionResult.second)
+				while (this->lhs_range.move_next())
 				{
-					this->iterator = insertionResult.first;
-					return true;
+					if (this->insert(this->lhs_range.get_value()))
+						return true;
 				}
+
+				this->lhs_done = true;
 			}
 			
-			while(this->lhs_range.move_next())
+			while (this->rhs_range.move_next())
 			{
-				const auto insertionResult = this->values.insert(this->lhs_range.get_value());
-				if(insertionResult.second)
-				{
-					this->iterator = insertionResult.first;
+				if (this->insert(this->rhs_range.get_value()))
 					return true;
-				}
 			}
 			
 			return false;
 		}
+
+	private:
+
+		template<typename TValue>
+		_NODISCARD bool insert(const TValue & value)
+		{
+			const auto insertion_result = this->values.insert(value);
+			this->position = insertion_result.first;
+			return insertion_result.second;
+		}
 	
 	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
 		
-		lhs_range_type    lhs_range;
-		rhs_range_type    rhs_range;
-		set_type          values;
-		set_iterator_type iterator;
+		lhs_range_type lhs_range;
+		rhs_range_type rhs_range;
+		set_type       values;
+		size_type      position;
+		bool           lhs_done;
+
 	};
 	
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Blocked Bloom filter on precomputed hashes. All bits of a key live in
+	/// one 64 byte block, so an insertion or lookup touches a single cache
+	/// line. A negative answer is exact, a positive one may be false with
+	/// roughly the rate the filter was sized for.
+	/// </summary>
+	class bloom_filter
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using size_type = std::size_t;
+
+	public:
+
+		/// <summary>
+		/// Creates an empty filter
+		/// </summary>
+		/// <param name="expected_count">the number of keys the filter gets sized for</param>
+		/// <param name="false_positive_rate">the targeted rate of false positives, between 0 and 1</param>
+		_NODISCARD_CTOR explicit bloom_filter(const size_type expected_count, const double false_positive_rate)
+			: blocks(), block_count(1), probes(1)
+		{
+			const double rate         = std::clamp(false_positive_rate, 1e-9, 0.5);
+			const double ln2          = std::log(2.0);
+			const double bits_per_key = -std::log(rate) / (ln2 * ln2);
+
+			// confining the bits to one block raises the false positive rate, a few more bits compensate
+			const double total_bits = std::max(1.0, static_cast<double>(expected_count) * bits_per_key * 1.2);
+
+			this->block_count = std::max<size_type>(1, static_cast<size_type>(std::ceil(total_bits / block_bits)));
+			this->probes      = static_cast<unsigned>(std::clamp(std::lround(bits_per_key * ln2), 1l, 16l));
+			this->blocks.resize(this->block_count);
+		}
+
+		/// <summary>
+		/// Adds a key
+		/// </summary>
+		/// <param name="hash">the hash of the key</param>
+		void insert(const size_type hash)
+		{
+			block & target = this->blocks[this->block_of(hash)];
+
+			this->for_each_bit(hash, [&target](const unsigned bit)
+			{
+				target.words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+				return true;
+			});
+		}
+
+		/// <summary>
+		/// Checks whether a key may have been added
+		/// </summary>
+		/// <param name="hash">the hash of the key</param>
+		/// <returns>false if the key has definitely not been added</returns>
+		_NODISCARD bool may_contain(const size_type hash) const
+		{
+			const block & target = this->blocks[this->block_of(hash)];
+
+			return this->for_each_bit(hash, [&target](const unsigned bit)
+			{
+				return (target.words[bit / 64] >> (bit % 64)) & 1;
+			});
+		}
+
+		/// <summary>
+		/// Returns the number of bytes the filter occupies
+		/// </summary>
+		_NODISCARD size_type memory_size() const
+		{
+			return this->blocks.size() * sizeof(block);
+		}
+
+	private:
+
+		inline static constexpr unsigned block_bits = 512;
+
+		/// <summary>
+		/// One cache line worth of bits
+		/// </summary>
+		struct alignas(64) block
+		{
+			std::uint64_t words[block_bits / 64] = {};
+		};
+
+		/// <summary>
+		/// Selects the block through the upper half of a mixed hash,
+		/// scaled onto the block count without a division
+		/// </summary>
+		_NODISCARD size_type block_of(const size_type hash) const
+		{
+			const std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+			return static_cast<size_type>(((mixed >> 32) * static_cast<std::uint64_t>(this->block_count)) >> 32);
+		}
+
+		/// <summary>
+		/// Derives the bits of a key inside its block through double hashing
+		/// on a second mix, stops as soon as visit returns false
+		/// </summary>
+		template<typename TVisit>
+		bool for_each_bit(const size_type hash, const TVisit & visit) const
+		{
+			std::uint64_t mixed = static_cast<std::uint64_t>(hash) ^ (static_cast<std::uint64_t>(hash) >> 31);
+			mixed *= 0xBF58476D1CE4E5B9ull;
+			mixed ^= mixed >> 29;
+
+			const unsigned first = static_cast<unsigned>(mixed) % block_bits;
+			const unsigned step  = static_cast<unsigned>(mixed >> 32) | 1;
+
+			for (unsigned probe = 0; probe < this->probes; ++probe)
+			{
+				if (!visit((first + probe * step) % block_bits))
+					return false;
+			}
+
+			return true;
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		std::vector<block> blocks;
+		size_type          block_count;
+		unsigned           probes;
+
+	};
+
+}
\ No newline at end of file
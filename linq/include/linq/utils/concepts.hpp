@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 
 namespace linq
 {
@@ -23,10 +24,23 @@ namespace linq
 		container.end();
 	};
 
+	template<typename TRange>
+	concept sized_range_concept = range_concept<TRange> && requires(const TRange & range)
+	{
+		{ range.size_hint() } -> std::convertible_to<std::size_t>;
+	};
+
 	template<typename TRange>
 	concept sorting_range_concept = range_concept<TRange> && requires(TRange range)
 	{
+		typename TRange::key_type;
 		{ range.compare_values(typename TRange::value_type{}, typename TRange::value_type{}) } -> std::same_as<bool>;
+		{ range.select_key(typename TRange::value_type{}) } -> std::same_as<typename TRange::key_type>;
+		{ range.get_directions() };
+		{ range.get_options() };
+		range.limit_to(std::size_t{});
+		range.select_nth(std::size_t{});
+		range.select_last();
 		{ range.forward_get_value() } -> std::same_as<typename TRange::return_type>;
 		{ range.forward_move_next() } -> std::same_as<bool>;
 	};
@@ -49,5 +49,20 @@ namespace linq
 		{
 		}
 	};
+
+	/// <summary>
+	/// Io_Exception definition (derives from std::exception)
+	/// thrown when a temporary file used for spilling to disk
+	/// cannot be created, written or read
+	/// </summary>
+	struct io_exception final : std::exception
+	{
+		using std::exception::exception;
+
+		io_exception()
+			: exception("io_exception")
+		{
+		}
+	};
 	
 }
\ No newline at end of file
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+#include <linq/utils/serializer.hpp>
+#include <linq/utils/temporary_file.hpp>
+#include <linq/utils/exceptions.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Opt-in policy to sort inputs larger than the available memory.
+	/// Once the buffered values exceed the memory budget they get sorted and
+	/// spilled to a temporary file, the sorted runs are merged lazily while
+	/// iterating.
+	/// </summary>
+	struct external_sort_policy
+	{
+		/// <summary>
+		/// estimated number of bytes the buffered values and their keys may occupy
+		/// </summary>
+		std::size_t memory_budget = std::size_t(64) << 20;
+
+		/// <summary>
+		/// directory for the run files, empty meaning the system's temporary directory
+		/// </summary>
+		std::filesystem::path directory = {};
+	};
+
+	/// <summary>
+	/// Estimates the heap memory a value owns on top of its own size, such as
+	/// the characters of a string key. Counts against the memory budget.
+	/// </summary>
+	template<typename TValue>
+	_NODISCARD std::size_t owned_heap_size(const TValue & value)
+	{
+		if constexpr (requires { std::tuple_size<TValue>::value; })
+		{
+			return std::apply([](const auto &... elements) { return (std::size_t(0) + ... + owned_heap_size(elements)); }, value);
+		}
+		else if constexpr (requires { value.capacity(); value.data(); })
+		{
+			return value.capacity() * sizeof(*value.data());
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	/// <summary>
+	/// Sorted runs spilled to disk together with the state of their k-way merge.
+	/// At most maximum_fan_in runs are open at once, more runs first get merged
+	/// into fewer, longer ones in as many passes as needed.
+	/// TValue has to satisfy serializable_concept once the runs are used.
+	/// </summary>
+	template<typename TValue, typename TKey>
+	class external_runs
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using value_type = TValue;
+		using key_type   = TKey;
+		using size_type  = std::size_t;
+
+		/// <summary>
+		/// Maximum number of run files merged, and therefore open, at once
+		/// </summary>
+		inline static constexpr size_type maximum_fan_in = 64;
+
+	public:
+
+		/// <summary>
+		/// Creates an empty set of runs
+		/// </summary>
+		/// <param name="directory">the directory to create the run files in</param>
+		_NODISCARD_CTOR explicit external_runs(const std::filesystem::path & directory)
+			: directory(directory), runs(), streams(), head_values(), heads(), current()
+		{
+		}
+
+		/// <summary>
+		/// Writes an already sorted sequence of values as a new run
+		/// </summary>
+		/// <param name="buffer">a buffer returning its values in sorted order through operator[]</param>
+		template<typename TBuffer>
+		void write(const TBuffer & buffer)
+		{
+			const std::unique_ptr<temporary_file> & file = this->runs.emplace_back(std::make_unique<temporary_file>(this->directory));
+
+			std::ofstream stream = file->open_write();
+			for (size_type position = 0; position < buffer.size(); ++position)
+				serializer<value_type>::write(stream, buffer[position]);
+
+			if (!stream.flush())
+				throw io_exception();
+		}
+
+		/// <summary>
+		/// Merges the runs down to at most maximum_fan_in, then opens
+		/// every remaining run and reads its first value
+		/// </summary>
+		/// <param name="select_key">extracts the sort key of a value</param>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		template<typename TSelectKey, typename TCompare>
+		void open(const TSelectKey & select_key, const TCompare & compare)
+		{
+			while (this->runs.size() > maximum_fan_in)
+				this->merge_pass(select_key, compare);
+
+			this->open_runs(0, this->runs.size(), select_key, compare);
+		}
+
+		/// <summary>
+		/// Moves the smallest head of all runs into the current value
+		/// </summary>
+		/// <param name="select_key">extracts the sort key of a value</param>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		template<typename TSelectKey, typename TCompare>
+		_NODISCARD bool move_next(const TSelectKey & select_key, const TCompare & compare)
+		{
+			return this->pop(this->current, select_key, compare);
+		}
+
+		/// <summary>
+		/// Returns the value the last call to move_next produced
+		/// </summary>
+		_NODISCARD const value_type & get_value() const
+		{
+			return this->current;
+		}
+
+		/// <summary>
+		/// Checks whether anything has been spilled
+		/// </summary>
+		_NODISCARD bool empty() const
+		{
+			return this->runs.empty();
+		}
+
+	private:
+
+		/// <summary>
+		/// The key of the next value of an open run. The value itself stays
+		/// in head_values, so keys viewing into it survive heap reordering.
+		/// </summary>
+		struct head
+		{
+			key_type  key;
+			size_type run;
+		};
+
+		/// <summary>
+		/// Merges every maximum_fan_in consecutive runs into one. Consecutive
+		/// runs keep equal keys in their original order, so the sort stays stable.
+		/// </summary>
+		template<typename TSelectKey, typename TCompare>
+		void merge_pass(const TSelectKey & select_key, const TCompare & compare)
+		{
+			std::vector<std::unique_ptr<temporary_file>> merged;
+
+			for (size_type first = 0; first < this->runs.size(); first += maximum_fan_in)
+			{
+				const size_type last = std::min(first + maximum_fan_in, this->runs.size());
+
+				this->open_runs(first, last, select_key, compare);
+
+				const std::unique_ptr<temporary_file> & file = merged.emplace_back(std::make_unique<temporary_file>(this->directory));
+				std::ofstream stream = file->open_write();
+
+				value_type value{};
+				while (this->pop(value, select_key, compare))
+					serializer<value_type>::write(stream, value);
+
+				if (!stream.flush())
+					throw io_exception();
+
+				this->streams.clear();
+			}
+
+			// deletes the merged runs
+			this->runs = std::move(merged);
+		}
+
+		/// <summary>
+		/// Opens the runs [first, last) and reads their first values
+		/// </summary>
+		template<typename TSelectKey, typename TCompare>
+		void open_runs(const size_type first, const size_type last, const TSelectKey & select_key, const TCompare & compare)
+		{
+			this->streams.clear();
+			this->heads.clear();
+			this->head_values.assign(last - first, value_type());
+			this->streams.reserve(last - first);
+
+			for (size_type index = first; index < last; ++index)
+			{
+				this->streams.push_back(this->runs[index]->open_read());
+				this->read_head(index - first, select_key, compare);
+			}
+		}
+
+		/// <summary>
+		/// Moves the smallest head into target and reads the next value of its run
+		/// </summary>
+		template<typename TSelectKey, typename TCompare>
+		_NODISCARD bool pop(value_type & target, const TSelectKey & select_key, const TCompare & compare)
+		{
+			if (this->heads.empty())
+				return false;
+
+			std::pop_heap(this->heads.begin(), this->heads.end(), make_heap_compare(compare));
+
+			const size_type run = this->heads.back().run;
+			this->heads.pop_back();
+
+			target = std::move(this->head_values[run]);
+			this->read_head(run, select_key, compare);
+
+			return true;
+		}
+
+		template<typename TSelectKey, typename TCompare>
+		void read_head(const size_type run, const TSelectKey & select_key, const TCompare & compare)
+		{
+			if (!serializer<value_type>::read(this->streams[run], this->head_values[run]))
+				return;
+
+			// the key is taken from the stored value, it may view into it
+			this->heads.push_back(head{ select_key(this->head_values[run]), run });
+			std::push_heap(this->heads.begin(), this->heads.end(), make_heap_compare(compare));
+		}
+
+		/// <summary>
+		/// Orders heads for a min-heap, equal keys are taken from earlier runs
+		/// first which keeps the merge stable
+		/// </summary>
+		template<typename TCompare>
+		_NODISCARD static auto make_heap_compare(const TCompare & compare)
+		{
+			return [&compare](const head & lhs, const head & rhs)
+			{
+				if (compare(rhs.key, lhs.key))
+					return true;
+
+				if (compare(lhs.key, rhs.key))
+					return false;
+
+				return rhs.run < lhs.run;
+			};
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		std::filesystem::path                        directory;
+		std::vector<std::unique_ptr<temporary_file>> runs;
+		std::vector<std::ifstream>                   streams;
+		std::vector<value_type>                      head_values;
+		std::vector<head>                            heads;
+		value_type                                   current;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include <linq/utils/hasher.hpp>
+#include <linq/utils/ordered_set.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Insert-only hash set on a flat open-addressing table with linear probing.
+	/// The values live in a dense vector in first-seen order, the table only
+	/// holds their hash and position, so there is no allocation per element
+	/// and lookups rarely touch a value that does not match.
+	/// </summary>
+	template<typename TValue, typename THasher = hasher<TValue>, typename TEqual = std::equal_to<TValue>>
+	class flat_hash_set
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using value_type  = TValue;
+		using hasher_type = THasher;
+		using equal_type  = TEqual;
+		using size_type   = std::size_t;
+
+		/// <summary>
+		/// Position returned by find if the value is not part of the set
+		/// </summary>
+		inline static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+	public:
+
+		/// <summary>
+		/// Creates an empty set
+		/// </summary>
+		/// <param name="hash">the hash function</param>
+		/// <param name="equal">the equality comparison, has to agree with the hash function</param>
+		_NODISCARD_CTOR explicit flat_hash_set(const hasher_type & hash = hasher_type(), const equal_type & equal = equal_type())
+			: hash(hash), equal(equal), values(), slots(), shift(std::numeric_limits<std::uint64_t>::digits)
+		{
+		}
+
+		/// <summary>
+		/// Inserts the value unless an equal one is already stored
+		/// </summary>
+		/// <param name="value">the value to insert</param>
+		/// <returns>the position of the stored value and whether it has just been inserted</returns>
+		std::pair<size_type, bool> insert(const value_type & value)
+		{
+			return this->emplace(value);
+		}
+
+		/// <summary>
+		/// Inserts the value unless an equal one is already stored
+		/// </summary>
+		/// <param name="value">the value to insert</param>
+		/// <returns>the position of the stored value and whether it has just been inserted</returns>
+		std::pair<size_type, bool> insert(value_type && value)
+		{
+			return this->emplace(std::move(value));
+		}
+
+		/// <summary>
+		/// Inserts the value using an already computed hash
+		/// </summary>
+		/// <param name="value">the value to insert</param>
+		/// <param name="hash">the value's hash, as computed by the set's hash function</param>
+		/// <returns>the position of the stored value and whether it has just been inserted</returns>
+		std::pair<size_type, bool> insert(const value_type & value, const size_type hash)
+		{
+			return this->emplace_hashed(value, hash);
+		}
+
+		/// <summary>
+		/// Looks up the position of a value
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		/// <returns>the position of the stored value or npos</returns>
+		_NODISCARD size_type find(const value_type & value) const
+		{
+			if (this->values.empty())
+				return npos;
+
+			return this->find(value, this->hash(value));
+		}
+
+		/// <summary>
+		/// Looks up the position of a value using an already computed hash
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		/// <param name="hash">the value's hash, as computed by the set's hash function</param>
+		/// <returns>the position of the stored value or npos</returns>
+		_NODISCARD size_type find(const value_type & value, const size_type hash) const
+		{
+			if (this->values.empty())
+				return npos;
+
+			const size_type mask = this->slots.size() - 1;
+
+			for (size_type slot = this->home(hash);; slot = (slot + 1) & mask)
+			{
+				const entry & current = this->slots[slot];
+
+				if (current.index == npos)
+					return npos;
+
+				if (current.hash == hash && this->equal(this->values[current.index], value))
+					return current.index;
+			}
+		}
+
+		/// <summary>
+		/// Checks whether an equal value is stored
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		_NODISCARD bool contains(const value_type & value) const
+		{
+			return this->find(value) != npos;
+		}
+
+		/// <summary>
+		/// Returns the value stored at a position, positions follow the insertion order
+		/// </summary>
+		_NODISCARD const value_type & operator [] (const size_type position) const
+		{
+			return this->values[position];
+		}
+
+		/// <summary>
+		/// Returns the hash function
+		/// </summary>
+		_NODISCARD const hasher_type & hash_function() const
+		{
+			return this->hash;
+		}
+
+		/// <summary>
+		/// Returns the number of stored values
+		/// </summary>
+		_NODISCARD size_type size() const
+		{
+			return this->values.size();
+		}
+
+		/// <summary>
+		/// Checks whether the set is empty
+		/// </summary>
+		_NODISCARD bool empty() const
+		{
+			return this->values.empty();
+		}
+
+		/// <summary>
+		/// Prepares the set for count values without growing in between
+		/// </summary>
+		/// <param name="count">the number of values to expect</param>
+		void reserve(const size_type count)
+		{
+			this->values.reserve(count);
+
+			if (count * 2 > this->slots.size())
+				this->rehash(count * 2);
+		}
+
+		/// <summary>
+		/// Removes all values and releases the memory
+		/// </summary>
+		void clear()
+		{
+			std::vector<value_type>().swap(this->values);
+			std::vector<entry>().swap(this->slots);
+			this->shift = std::numeric_limits<std::uint64_t>::digits;
+		}
+
+	private:
+
+		/// <summary>
+		/// A table slot referencing a stored value, an index of npos marks an empty slot
+		/// </summary>
+		struct entry
+		{
+			size_type hash;
+			size_type index;
+		};
+
+		template<typename TArgument>
+		std::pair<size_type, bool> emplace(TArgument && value)
+		{
+			const size_type hash = this->hash(value);
+			return this->emplace_hashed(std::forward<TArgument>(value), hash);
+		}
+
+		template<typename TArgument>
+		std::pair<size_type, bool> emplace_hashed(TArgument && value, const size_type hash)
+		{
+			// keep the load factor at or below one half
+			if ((this->values.size() + 1) * 2 > this->slots.size())
+				this->rehash(std::max<size_type>(16, this->slots.size() * 2));
+
+			const size_type mask = this->slots.size() - 1;
+
+			for (size_type slot = this->home(hash);; slot = (slot + 1) & mask)
+			{
+				entry & current = this->slots[slot];
+
+				if (current.index == npos)
+				{
+					current = entry{ hash, this->values.size() };
+					this->values.push_back(std::forward<TArgument>(value));
+					return { current.index, true };
+				}
+
+				if (current.hash == hash && this->equal(this->values[current.index], value))
+					return { current.index, false };
+			}
+		}
+
+		/// <summary>
+		/// Maps a hash onto its preferred slot. The multiplication spreads weak
+		/// hashes such as the identity std::hash of integers over all slots.
+		/// </summary>
+		_NODISCARD size_type home(const size_type hash) const
+		{
+			return static_cast<size_type>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> this->shift);
+		}
+
+		void rehash(const size_type minimum)
+		{
+			size_type capacity = 16;
+			unsigned  bits     = 4;
+
+			while (capacity < minimum)
+			{
+				capacity *= 2;
+				++bits;
+			}
+
+			std::vector<entry> previous(capacity, entry{ 0, npos });
+			previous.swap(this->slots);
+			this->shift = std::numeric_limits<std::uint64_t>::digits - bits;
+
+			const size_type mask = capacity - 1;
+
+			// the stored hashes make growing independent of the hash function's cost
+			for (const entry & current : previous)
+			{
+				if (current.index == npos)
+					continue;
+
+				size_type slot = this->home(current.hash);
+				while (this->slots[slot].index != npos)
+					slot = (slot + 1) & mask;
+
+				this->slots[slot] = current;
+			}
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		hasher_type             hash;
+		equal_type              equal;
+		std::vector<value_type> values;
+		std::vector<entry>      slots;
+		unsigned                shift;
+
+	};
+
+	/// <summary>
+	/// Set the set-based operators use by default: a flat_hash_set if the
+	/// default hasher supports the value type, an ordered_set otherwise
+	/// </summary>
+	template<typename TValue>
+	using default_set_t = std::conditional_t<hashable_concept<TValue>, flat_hash_set<TValue>, ordered_set<TValue>>;
+
+}
\ No newline at end of file
@@ -0,0 +1,557 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <fstream>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+
+#include <linq/utils/hasher.hpp>
+#include <linq/utils/serializer.hpp>
+#include <linq/utils/exceptions.hpp>
+#include <linq/utils/flat_hash_set.hpp>
+#include <linq/utils/temporary_file.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Opt-in policy to group or deduplicate inputs with more distinct keys
+	/// than fit into memory. Once the groups held in memory exceed the memory
+	/// budget, values of unseen keys get hash partitioned into temporary files,
+	/// which are processed one by one afterwards.
+	/// </summary>
+	struct external_hash_policy
+	{
+		/// <summary>
+		/// estimated number of bytes the groups held in memory may occupy
+		/// </summary>
+		std::size_t memory_budget = std::size_t(64) << 20;
+
+		/// <summary>
+		/// directory for the partition files, empty meaning the system's temporary directory
+		/// </summary>
+		std::filesystem::path directory = {};
+	};
+
+	/// <summary>
+	/// Temporary file of records, each made of one serialized value per field.
+	/// It is written first and read back once afterwards.
+	/// </summary>
+	template<typename... TFields>
+	class record_file
+	{
+	public:
+
+		/// <summary>
+		/// Creates an empty file, open for writing
+		/// </summary>
+		/// <param name="directory">the directory to create the file in</param>
+		_NODISCARD_CTOR explicit record_file(const std::filesystem::path & directory)
+			: file(directory), output(file.open_write()), input()
+		{
+		}
+
+		/// <summary>
+		/// Appends a record
+		/// </summary>
+		void write(const TFields & ... fields)
+		{
+			(serializer<TFields>::write(this->output, fields), ...);
+		}
+
+		/// <summary>
+		/// Finishes writing, the file stays closed until it gets rewound
+		/// </summary>
+		void finish()
+		{
+			if (!this->output.is_open())
+				return;
+
+			if (!this->output.flush())
+				throw io_exception();
+
+			this->output.close();
+		}
+
+		/// <summary>
+		/// Finishes writing, the records can be read afterwards
+		/// </summary>
+		void rewind()
+		{
+			this->finish();
+			this->input = this->file.open_read();
+		}
+
+		/// <summary>
+		/// Reads the next record, returns false at the end of the file
+		/// </summary>
+		_NODISCARD bool read(TFields & ... fields)
+		{
+			return (serializer<TFields>::read(this->input, fields) && ...);
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		temporary_file file;
+		std::ofstream  output;
+		std::ifstream  input;
+
+	};
+
+	/// <summary>
+	/// Hash aggregation folding every value into the state of its key, which
+	/// starts at the seed. The groups are yielded in the order their keys were
+	/// seen first, every state got the values of its key folded in input order.
+	///
+	/// With an external_hash_policy the memory held is bounded: once the
+	/// groups exceed the budget, the table is frozen. Values of known keys are
+	/// still folded in memory, the ones of unseen keys get written to one of
+	/// several partition files by the hash of their key, together with their
+	/// position in the input. Every partition is aggregated the same way after
+	/// the input ends, recursively if it exceeds the budget as well. All groups
+	/// end up in runs ordered by the position of their first value, a merge of
+	/// the runs yields the same sequence the in-memory aggregation would.
+	/// Runs stay closed until the merge, which reads at most maximum_fan_in
+	/// of them at once and merges more runs into fewer ones first.
+	/// </summary>
+	template<typename TValue, typename TKeySelector, typename TState, typename TFold, typename TSet>
+	class hash_aggregation
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using value_type        = std::remove_cvref_t<TValue>;
+		using key_selector_type = std::remove_cvref_t<TKeySelector>;
+		using state_type        = std::remove_cvref_t<TState>;
+		using fold_type         = std::remove_cvref_t<TFold>;
+		using set_type          = std::remove_cvref_t<TSet>;
+		using key_type          = typename set_type::value_type;
+		using size_type         = std::size_t;
+
+		/// <summary>
+		/// Whether the aggregation is able to spill, which needs hashed keys
+		/// and serializers for the values, keys and states
+		/// </summary>
+		inline static constexpr bool spillable =
+			std::is_same_v<set_type, flat_hash_set<key_type, typename set_type::hasher_type, typename set_type::equal_type>> &&
+			serializable_concept<value_type> && serializable_concept<key_type> && serializable_concept<state_type>;
+
+		/// <summary>
+		/// What happened to an added value
+		/// </summary>
+		enum class add_result
+		{
+			/// <summary>
+			/// its key was unseen and has been added to the groups held in memory
+			/// </summary>
+			inserted,
+
+			/// <summary>
+			/// it was folded into the group of a key held in memory
+			/// </summary>
+			folded,
+
+			/// <summary>
+			/// its key is unseen and the value has been spilled to disk
+			/// </summary>
+			spilled
+		};
+
+	public:
+
+		/// <summary>
+		/// Creates an empty aggregation
+		/// </summary>
+		/// <param name="key_selector">function to select the key of a value</param>
+		/// <param name="seed">the state every group starts with</param>
+		/// <param name="fold">function to fold a value into the state of its group</param>
+		/// <param name="keys">an empty set carrying the hash function and equality to use</param>
+		/// <param name="external">the memory budget, none meaning everything stays in memory</param>
+		_NODISCARD_CTOR explicit hash_aggregation(
+			const key_selector_type & key_selector,
+			const state_type & seed,
+			const fold_type & fold,
+			const set_type & keys,
+			const std::optional<external_hash_policy> & external
+		) : key_selector(key_selector),
+			seed(seed),
+			fold(fold),
+			prototype(keys),
+			external(external),
+			top(keys),
+			count(0),
+			position(0),
+			runs(),
+			active(),
+			heads(),
+			order(),
+			current(0)
+		{
+		}
+
+		/// <summary>
+		/// Adds the next value of the input
+		/// </summary>
+		add_result add(const value_type & value)
+		{
+			return this->add(this->top, this->count++, value, 0);
+		}
+
+		/// <summary>
+		/// Ends the input, the groups can be read through next afterwards
+		/// </summary>
+		/// <param name="resident">whether to yield the groups which have been held in memory from the start as well</param>
+		void finish(const bool resident)
+		{
+			if (this->top.partitions.empty())
+			{
+				if (!resident)
+					this->top = table(this->prototype);
+
+				// the increment of next moves onto the first group
+				this->position = size_type(-1);
+				return;
+			}
+
+			if constexpr (spillable)
+			{
+				if (resident)
+					this->write_run(this->top);
+
+				this->drain(this->top, 0);
+
+				while (this->runs.size() > maximum_fan_in)
+					this->merge_pass();
+
+				this->open_runs(0, this->runs.size());
+			}
+		}
+
+		/// <summary>
+		/// Moves onto the next group, in the order the keys have been seen first
+		/// </summary>
+		_NODISCARD bool next()
+		{
+			if (this->runs.empty())
+				return ++this->position < this->top.states.size();
+
+			return this->next_head();
+		}
+
+		/// <summary>
+		/// Returns the key of the current group
+		/// </summary>
+		_NODISCARD const key_type & key() const
+		{
+			if (this->runs.empty())
+				return this->top.keys[this->position];
+
+			return this->heads[this->current].key;
+		}
+
+		/// <summary>
+		/// Returns the state of the current group
+		/// </summary>
+		_NODISCARD const state_type & state() const
+		{
+			if (this->runs.empty())
+				return this->top.states[this->position];
+
+			return this->heads[this->current].state;
+		}
+
+		/// <summary>
+		/// Checks whether values have been spilled to disk
+		/// </summary>
+		_NODISCARD bool spilled() const
+		{
+			return !this->top.partitions.empty() || !this->runs.empty();
+		}
+
+	private:
+
+		/// <summary>
+		/// Partitions per spill, every level of recursion takes the next bits of the hash
+		/// </summary>
+		inline static constexpr unsigned partition_bits = 4;
+		inline static constexpr unsigned maximum_depth  = std::numeric_limits<std::uint64_t>::digits / partition_bits;
+
+		/// <summary>
+		/// Maximum number of runs merged, and therefore open, at once
+		/// </summary>
+		inline static constexpr size_type maximum_fan_in = 64;
+
+		using partition_file = record_file<size_type, value_type>;
+		using run_file       = record_file<size_type, key_type, state_type>;
+
+		/// <summary>
+		/// Groups held in memory, with the partition files of the spilled values once frozen
+		/// </summary>
+		struct table
+		{
+			explicit table(const set_type & keys)
+				: keys(keys), states(), firsts(), bytes(0), partitions()
+			{
+			}
+
+			set_type                                     keys;
+			std::vector<state_type>                      states;
+			std::vector<size_type>                       firsts;
+			size_type                                    bytes;
+			std::vector<std::shared_ptr<partition_file>> partitions;
+		};
+
+		/// <summary>
+		/// The next group of a run
+		/// </summary>
+		struct head
+		{
+			size_type  first;
+			key_type   key;
+			state_type state;
+		};
+
+		add_result add(table & target, const size_type sequence, const value_type & value, const unsigned depth)
+		{
+			const key_type key = this->key_selector(value);
+
+			if (target.partitions.empty())
+			{
+				const auto [group, inserted] = target.keys.insert(key);
+
+				if (inserted)
+					this->states_push(target, sequence, key, depth);
+
+				target.states[group] = this->fold(std::move(target.states[group]), value);
+				return inserted ? add_result::inserted : add_result::folded;
+			}
+
+			if constexpr (spillable)
+			{
+				const size_type hash  = target.keys.hash_function()(key);
+				const size_type group = target.keys.find(key, hash);
+
+				if (group != set_type::npos)
+				{
+					target.states[group] = this->fold(std::move(target.states[group]), value);
+					return add_result::folded;
+				}
+
+				std::shared_ptr<partition_file> & partition = target.partitions[partition_of(hash, depth)];
+				if (!partition)
+					partition = std::make_shared<partition_file>(this->external->directory);
+
+				partition->write(sequence, value);
+			}
+
+			return add_result::spilled;
+		}
+
+		/// <summary>
+		/// Starts the state of a new group, freezes the table once the budget is exceeded
+		/// </summary>
+		void states_push(table & target, const size_type sequence, const key_type & key, const unsigned depth)
+		{
+			target.states.push_back(this->seed);
+
+			if constexpr (spillable)
+			{
+				if (!this->external)
+					return;
+
+				target.firsts.push_back(sequence);
+
+				// the slots of the hash table are at most half full
+				target.bytes += serializer<key_type>::size(key) + serializer<state_type>::size(this->seed) + 5 * sizeof(size_type);
+
+				// the partition files get created once a value is spilled to them
+				if (target.bytes >= this->external->memory_budget && depth + 1 < maximum_depth)
+					target.partitions.resize(size_type(1) << partition_bits);
+			}
+		}
+
+		/// <summary>
+		/// Aggregates the partitions of a frozen table one by one, every
+		/// partition's groups become a run. Frees the memory of the table first.
+		/// </summary>
+		void drain(table & source, const unsigned depth)
+		{
+			std::vector<std::shared_ptr<partition_file>> partitions = std::move(source.partitions);
+			source = table(this->prototype);
+
+			// only the partition being aggregated stays open
+			for (const std::shared_ptr<partition_file> & partition : partitions)
+			{
+				if (partition)
+					partition->finish();
+			}
+
+			for (std::shared_ptr<partition_file> & partition : partitions)
+			{
+				if (!partition)
+					continue;
+
+				partition->rewind();
+
+				table part(this->prototype);
+
+				size_type  sequence = 0;
+				value_type value{};
+				while (partition->read(sequence, value))
+					this->add(part, sequence, value, depth + 1);
+
+				partition.reset();
+
+				this->write_run(part);
+
+				if (!part.partitions.empty())
+					this->drain(part, depth + 1);
+			}
+		}
+
+		/// <summary>
+		/// Writes the groups of a table to a run, which is ordered by the
+		/// position of their first values since the keys are in first-seen order
+		/// </summary>
+		void write_run(const table & source)
+		{
+			if (source.states.empty())
+				return;
+
+			run_file & run = *this->runs.emplace_back(std::make_shared<run_file>(this->external->directory));
+
+			for (size_type group = 0; group < source.states.size(); ++group)
+				run.write(source.firsts[group], source.keys[group], source.states[group]);
+
+			run.finish();
+		}
+
+		/// <summary>
+		/// Merges every maximum_fan_in consecutive runs into one. The merged run
+		/// is ordered by first position again, so the grouping does not matter.
+		/// </summary>
+		void merge_pass()
+		{
+			std::vector<std::shared_ptr<run_file>> merged;
+
+			for (size_type first = 0; first < this->runs.size(); first += maximum_fan_in)
+			{
+				const size_type last = std::min(first + maximum_fan_in, this->runs.size());
+
+				this->open_runs(first, last);
+
+				run_file & run = *merged.emplace_back(std::make_shared<run_file>(this->external->directory));
+
+				while (this->next_head())
+				{
+					const head & group = this->heads[this->current];
+					run.write(group.first, group.key, group.state);
+				}
+
+				run.finish();
+
+				// closes and deletes the merged runs
+				this->active.clear();
+				for (size_type index = first; index < last; ++index)
+					this->runs[index].reset();
+			}
+
+			this->runs = std::move(merged);
+		}
+
+		/// <summary>
+		/// Opens the runs [first, last) and reads their first groups
+		/// </summary>
+		void open_runs(const size_type first, const size_type last)
+		{
+			this->active.assign(this->runs.begin() + first, this->runs.begin() + last);
+			this->heads.resize(this->active.size());
+			this->order.clear();
+
+			for (size_type run = 0; run < this->active.size(); ++run)
+			{
+				this->active[run]->rewind();
+				this->read_head(run);
+			}
+
+			this->current = this->active.size();
+		}
+
+		/// <summary>
+		/// Moves onto the group with the smallest first position of all open runs
+		/// </summary>
+		_NODISCARD bool next_head()
+		{
+			// the run of the previous group advances only now, its head was still referenced
+			if (this->current < this->active.size())
+				this->read_head(this->current);
+
+			if (this->order.empty())
+				return false;
+
+			std::pop_heap(this->order.begin(), this->order.end(), std::greater<>());
+			this->current = this->order.back().second;
+			this->order.pop_back();
+
+			return true;
+		}
+
+		void read_head(const size_type run)
+		{
+			head & target = this->heads[run];
+
+			if (this->active[run]->read(target.first, target.key, target.state))
+			{
+				this->order.emplace_back(target.first, run);
+				std::push_heap(this->order.begin(), this->order.end(), std::greater<>());
+			}
+		}
+
+		/// <summary>
+		/// Selects the partition of a hash at a level of recursion through the
+		/// bits of a mix which differs from the one the hash table uses
+		/// </summary>
+		_NODISCARD static size_type partition_of(const size_type hash, const unsigned depth)
+		{
+			const std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0xD6E8FEB86659FD93ull;
+			const unsigned      shift = std::numeric_limits<std::uint64_t>::digits - (depth + 1) * partition_bits;
+
+			return static_cast<size_type>((mixed >> shift) & ((std::uint64_t(1) << partition_bits) - 1));
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		key_selector_type                   key_selector;
+		state_type                          seed;
+		fold_type                           fold;
+		set_type                            prototype;
+		std::optional<external_hash_policy> external;
+
+		table                                        top;
+		size_type                                    count;
+		size_type                                    position;
+		std::vector<std::shared_ptr<run_file>>       runs;
+		std::vector<std::shared_ptr<run_file>>       active;
+		std::vector<head>                            heads;
+		std::vector<std::pair<size_type, size_type>> order;
+		size_type                                    current;
+
+	};
+
+}
\ No newline at end of file
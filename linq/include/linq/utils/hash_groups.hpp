@@ -0,0 +1,440 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <utility>
+
+#include <linq/utils/concepts.hpp>
+#include <linq/utils/parallel.hpp>
+#include <linq/utils/flat_hash_set.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Values grouped by key in compressed sparse row layout: the values of
+	/// all groups share one contiguous array, ordered by group, and each
+	/// group is a slice of it. Keys are stored once, in a set mapping each
+	/// one onto its group, so every key gets hashed exactly once.
+	///
+	/// Groups are numbered in the order their keys are seen first, the
+	/// values of a group keep the order they were added in.
+	/// </summary>
+	template<typename TKey, typename TValue, typename TKeySet = default_set_t<TKey>>
+	class hash_groups
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using key_type     = TKey;
+		using value_type   = TValue;
+		using key_set_type = TKeySet;
+		using size_type    = std::size_t;
+
+		/// <summary>
+		/// Group returned by find if the key is unknown
+		/// </summary>
+		inline static constexpr size_type npos = key_set_type::npos;
+
+	public:
+
+		/// <summary>
+		/// Creates empty groups
+		/// </summary>
+		/// <param name="keys">an empty key set carrying the hash function and equality to use</param>
+		_NODISCARD_CTOR explicit hash_groups(const key_set_type & keys = key_set_type())
+			: keys(keys), offsets(), values(), staged_groups(), staged_values()
+		{
+		}
+
+		/// <summary>
+		/// Adopts groups which are already laid out
+		/// </summary>
+		/// <param name="keys">the keys, the position of a key being its group</param>
+		/// <param name="offsets">the position of the first value of every group, followed by the total</param>
+		/// <param name="values">the values, ordered by group</param>
+		_NODISCARD_CTOR explicit hash_groups(key_set_type keys, std::vector<size_type> offsets, std::vector<value_type> values)
+			: keys(std::move(keys)), offsets(std::move(offsets)), values(std::move(values)), staged_groups(), staged_values()
+		{
+		}
+
+		/// <summary>
+		/// Adds a value to the group of its key, only allowed before build
+		/// </summary>
+		/// <param name="key">the key of the value</param>
+		/// <param name="value">the value to add</param>
+		void add(const key_type & key, const value_type & value)
+		{
+			this->staged_groups.push_back(this->keys.insert(key).first);
+			this->staged_values.push_back(value);
+		}
+
+		/// <summary>
+		/// Adds a value to the group of its key, whose hash is already known
+		/// </summary>
+		/// <param name="key">the key of the value</param>
+		/// <param name="value">the value to add</param>
+		/// <param name="hash">the hash of the key, computed by the hash function of the key set</param>
+		void add(const key_type & key, const value_type & value, const size_type hash)
+		{
+			this->staged_groups.push_back(this->keys.insert(key, hash).first);
+			this->staged_values.push_back(value);
+		}
+
+		/// <summary>
+		/// Reserves room for the given number of values
+		/// </summary>
+		void reserve(const size_type count)
+		{
+			this->staged_groups.reserve(count);
+			this->staged_values.reserve(count);
+		}
+
+		/// <summary>
+		/// Lays out the added values group by group, a counting sort
+		/// which keeps the order of the values inside a group
+		/// </summary>
+		void build()
+		{
+			const size_type group_count = this->keys.size();
+
+			this->offsets.assign(group_count + 1, 0);
+			for (const size_type group : this->staged_groups)
+				++this->offsets[group + 1];
+
+			for (size_type group = 0; group < group_count; ++group)
+				this->offsets[group + 1] += this->offsets[group];
+
+			std::vector<size_type> order(this->staged_values.size());
+			{
+				std::vector<size_type> next(this->offsets.begin(), this->offsets.end() - 1);
+				for (size_type index = 0; index < this->staged_groups.size(); ++index)
+					order[next[this->staged_groups[index]]++] = index;
+			}
+
+			this->values.clear();
+			this->values.reserve(order.size());
+			for (const size_type index : order)
+				this->values.push_back(std::move(this->staged_values[index]));
+
+			std::vector<size_type>().swap(this->staged_groups);
+			std::vector<value_type>().swap(this->staged_values);
+		}
+
+		/// <summary>
+		/// Looks up the group of a key
+		/// </summary>
+		/// <param name="key">the key to look for</param>
+		/// <returns>the group or npos</returns>
+		_NODISCARD size_type find(const key_type & key) const
+		{
+			return this->keys.find(key);
+		}
+
+		/// <summary>
+		/// Looks up the group of a key whose hash is already known
+		/// </summary>
+		/// <param name="key">the key to look for</param>
+		/// <param name="hash">the hash of the key, computed by the hash function of the key set</param>
+		/// <returns>the group or npos</returns>
+		_NODISCARD size_type find(const key_type & key, const size_type hash) const
+		{
+			return this->keys.find(key, hash);
+		}
+
+		/// <summary>
+		/// Returns the position of the first value of a group
+		/// </summary>
+		_NODISCARD size_type begin(const size_type group) const
+		{
+			return this->offsets[group];
+		}
+
+		/// <summary>
+		/// Returns the position behind the last value of a group
+		/// </summary>
+		_NODISCARD size_type end(const size_type group) const
+		{
+			return this->offsets[group + 1];
+		}
+
+		/// <summary>
+		/// Returns the key of a group
+		/// </summary>
+		_NODISCARD const key_type & key(const size_type group) const
+		{
+			return this->keys[group];
+		}
+
+		/// <summary>
+		/// Returns the shared value array
+		/// </summary>
+		_NODISCARD const value_type * data() const
+		{
+			return this->values.data();
+		}
+
+		/// <summary>
+		/// Returns the value at a position of the shared value array
+		/// </summary>
+		_NODISCARD const value_type & operator [] (const size_type position) const
+		{
+			return this->values[position];
+		}
+
+		/// <summary>
+		/// Returns the number of groups
+		/// </summary>
+		_NODISCARD size_type group_count() const
+		{
+			return this->keys.size();
+		}
+
+		/// <summary>
+		/// Returns the number of values of all groups
+		/// </summary>
+		_NODISCARD size_type size() const
+		{
+			return this->values.size();
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		key_set_type            keys;
+		std::vector<size_type>  offsets;
+		std::vector<value_type> values;
+		std::vector<size_type>  staged_groups;
+		std::vector<value_type> staged_values;
+
+	};
+
+	/// <summary>
+	/// Loads a range into hash groups keyed by the selected id. This is
+	/// the build step every hash join shares.
+	/// </summary>
+	/// <param name="range">the range to consume</param>
+	/// <param name="id_selection">function to select the id of a value</param>
+	template<typename TGroups, typename TRange, typename TIdSelection>
+	_NODISCARD TGroups make_hash_groups(TRange & range, const TIdSelection & id_selection)
+	{
+		TGroups groups;
+
+		while (range.move_next())
+		{
+			const auto & value = range.get_value();
+			groups.add(id_selection(value), value);
+		}
+
+		groups.build();
+		return groups;
+	}
+
+	/// <summary>
+	/// Loads a range into hash groups on multiple threads. Every thread
+	/// groups one chunk of the values into its own partial key set, the
+	/// partial keys are then merged chunk by chunk and every thread copies
+	/// its values into their final slots. The result equals the one of the
+	/// sequential build: keys in first-seen order, the values of a group in
+	/// input order. The id selection gets invoked concurrently.
+	/// </summary>
+	/// <param name="range">the range to consume</param>
+	/// <param name="id_selection">function to select the id of a value</param>
+	/// <param name="policy">the parallel policy to respect</param>
+	template<typename TGroups, typename TRange, typename TIdSelection>
+	_NODISCARD TGroups make_hash_groups(TRange & range, const TIdSelection & id_selection, const parallel_policy & policy)
+	{
+		using key_set_type = typename TGroups::key_set_type;
+		using value_type   = typename TGroups::value_type;
+		using size_type    = typename TGroups::size_type;
+
+		std::vector<value_type> input;
+		if constexpr (sized_range_concept<TRange>)
+			input.reserve(range.size_hint());
+
+		while (range.move_next())
+			input.push_back(range.get_value());
+
+		const size_type size    = input.size();
+		const size_type threads = policy.threads_for(size);
+
+		if (threads == 1)
+		{
+			TGroups groups;
+			groups.reserve(size);
+
+			for (const value_type & value : input)
+				groups.add(id_selection(value), value);
+
+			groups.build();
+			return groups;
+		}
+
+		// thread-local partials: the chunk's keys and the partial group of every value
+		struct partial
+		{
+			key_set_type           keys;
+			std::vector<size_type> groups;
+			std::vector<size_type> slots;
+			std::vector<size_type> merged;
+		};
+
+		std::vector<partial> partials(threads);
+
+		parallel_for(threads, threads, [&](const size_type chunk)
+		{
+			partial & local = partials[chunk];
+			local.groups.reserve(size * (chunk + 1) / threads - size * chunk / threads);
+
+			for (size_type index = size * chunk / threads; index < size * (chunk + 1) / threads; ++index)
+				local.groups.push_back(local.keys.insert(id_selection(input[index])).first);
+		});
+
+		// merging chunk by chunk keeps the first-seen order, every partial
+		// group gets its place among the values of the final group
+		key_set_type           keys;
+		std::vector<size_type> totals;
+
+		for (size_type chunk = 0; chunk < threads; ++chunk)
+		{
+			partial & local = partials[chunk];
+
+			std::vector<size_type> counts(local.keys.size(), 0);
+			for (const size_type group : local.groups)
+				++counts[group];
+
+			local.merged.resize(local.keys.size());
+			local.slots.resize(local.keys.size());
+
+			for (size_type group = 0; group < local.keys.size(); ++group)
+			{
+				const size_type merged = keys.insert(local.keys[group]).first;
+				if (merged == totals.size())
+					totals.push_back(0);
+
+				local.merged[group] = merged;
+				local.slots[group]  = totals[merged];
+				totals[merged]     += counts[group];
+			}
+
+			local.keys = key_set_type();
+		}
+
+		std::vector<size_type> offsets(totals.size() + 1, 0);
+		for (size_type group = 0; group < totals.size(); ++group)
+			offsets[group + 1] = offsets[group] + totals[group];
+
+		std::vector<size_type> order(size);
+
+		parallel_for(threads, threads, [&](const size_type chunk)
+		{
+			partial & local = partials[chunk];
+			const size_type first = size * chunk / threads;
+
+			for (size_type index = 0; index < local.groups.size(); ++index)
+			{
+				const size_type group = local.groups[index];
+				order[offsets[local.merged[group]] + local.slots[group]++] = first + index;
+			}
+		});
+
+		partials.clear();
+
+		std::vector<value_type> values(size);
+
+		parallel_for(threads, threads, [&](const size_type chunk)
+		{
+			for (size_type index = size * chunk / threads; index < size * (chunk + 1) / threads; ++index)
+				values[index] = std::move(input[order[index]]);
+		});
+
+		return TGroups(std::move(keys), std::move(offsets), std::move(values));
+	}
+
+	/// <summary>
+	/// Read-only view of the values of one group. The view shares ownership
+	/// of the groups, so it stays valid on its own and copying it never
+	/// copies any value. It can be iterated directly or passed to linq::from.
+	/// </summary>
+	template<typename TGroups>
+	class hash_group_view
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using groups_type    = TGroups;
+		using value_type     = typename groups_type::value_type;
+		using size_type      = typename groups_type::size_type;
+		using const_iterator = const value_type *;
+		using iterator       = const_iterator;
+
+	public:
+
+		/// <summary>
+		/// Creates an empty view
+		/// </summary>
+		_NODISCARD_CTOR hash_group_view()
+			: groups(), first(nullptr), last(nullptr)
+		{
+		}
+
+		/// <summary>
+		/// Creates a view of a group
+		/// </summary>
+		/// <param name="groups">the groups to share</param>
+		/// <param name="group">the group to view, npos meaning an empty view</param>
+		_NODISCARD_CTOR hash_group_view(const std::shared_ptr<const groups_type> & groups, const size_type group)
+			: groups(groups), first(nullptr), last(nullptr)
+		{
+			if (group != groups_type::npos)
+			{
+				this->first = groups->data() + groups->begin(group);
+				this->last  = groups->data() + groups->end(group);
+			}
+		}
+
+		_NODISCARD const_iterator begin() const
+		{
+			return this->first;
+		}
+
+		_NODISCARD const_iterator end() const
+		{
+			return this->last;
+		}
+
+		_NODISCARD size_type size() const
+		{
+			return static_cast<size_type>(this->last - this->first);
+		}
+
+		_NODISCARD bool empty() const
+		{
+			return this->first == this->last;
+		}
+
+		_NODISCARD const value_type & operator [] (const size_type position) const
+		{
+			return this->first[position];
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		std::shared_ptr<const groups_type> groups;
+		const_iterator                     first;
+		const_iterator                     last;
+
+	};
+
+}
\ No newline at end of file
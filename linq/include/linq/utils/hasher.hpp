@@ -0,0 +1,77 @@
+#pragma once
+
+#include <tuple>
+#include <cstdint>
+#include <utility>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Types std::hash is enabled for
+	/// </summary>
+	template<typename TValue>
+	concept std_hashable_concept = std::is_default_constructible_v<std::hash<TValue>> && requires(const TValue & value)
+	{
+		{ std::hash<TValue>{}(value) } -> std::convertible_to<std::size_t>;
+	};
+
+	/// <summary>
+	/// Combines the hash of another part into the running seed
+	/// </summary>
+	/// <param name="seed">the hash of the parts combined so far</param>
+	/// <param name="hash">the hash of the next part</param>
+	_NODISCARD inline std::size_t combine_hashes(const std::size_t seed, const std::size_t hash)
+	{
+		return seed ^ (hash + std::size_t(0x9E3779B97F4A7C15ull) + (seed << 6) + (seed >> 2));
+	}
+
+	/// <summary>
+	/// Default hash function of the hash-based operators. Delegates to
+	/// std::hash and additionally supports std::pair and std::tuple, so
+	/// composite keys work out of the box.
+	/// </summary>
+	template<typename TValue>
+	struct hasher
+	{
+		_NODISCARD std::size_t operator()(const TValue & value) const requires std_hashable_concept<TValue>
+		{
+			return std::hash<TValue>{}(value);
+		}
+	};
+
+	template<typename TFirst, typename TSecond>
+	struct hasher<std::pair<TFirst, TSecond>>
+	{
+		_NODISCARD std::size_t operator()(const std::pair<TFirst, TSecond> & value) const
+			requires std::is_invocable_v<hasher<TFirst>, const TFirst &> && std::is_invocable_v<hasher<TSecond>, const TSecond &>
+		{
+			return combine_hashes(hasher<TFirst>{}(value.first), hasher<TSecond>{}(value.second));
+		}
+	};
+
+	template<typename... TValues>
+	struct hasher<std::tuple<TValues...>>
+	{
+		_NODISCARD std::size_t operator()(const std::tuple<TValues...> & value) const
+			requires (std::is_invocable_v<hasher<TValues>, const TValues &> && ...)
+		{
+			return std::apply([](const TValues & ... parts)
+			{
+				std::size_t seed = 0;
+				((seed = combine_hashes(seed, hasher<TValues>{}(parts))), ...);
+				return seed;
+			}, value);
+		}
+	};
+
+	/// <summary>
+	/// Types the default hasher supports
+	/// </summary>
+	template<typename TValue>
+	concept hashable_concept = std::is_invocable_r_v<std::size_t, hasher<TValue>, const TValue &>;
+
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <set>
+#include <limits>
+#include <vector>
+#include <utility>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Insert-only set with the interface of flat_hash_set for value types
+	/// which can be ordered but not hashed. Values get positions in
+	/// first-seen order.
+	///
+	/// Every value is stored once, in the insertion-ordered vector. The
+	/// ordered index only holds positions into it, compared by the values
+	/// they refer to.
+	/// </summary>
+	template<typename TValue>
+	class ordered_set
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using value_type = TValue;
+		using size_type  = std::size_t;
+
+		/// <summary>
+		/// Position returned by find if the value is not part of the set
+		/// </summary>
+		inline static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+	private:
+
+		/// <summary>
+		/// A value looked up in the index, kept apart from positions
+		/// so that sets of integers cannot mix both up
+		/// </summary>
+		struct probe
+		{
+			const value_type & value;
+		};
+
+		/// <summary>
+		/// Orders positions by the values they refer to
+		/// </summary>
+		struct position_compare
+		{
+			using is_transparent = void;
+
+			const std::vector<value_type> * values;
+
+			_NODISCARD bool operator()(const size_type lhs, const size_type rhs) const
+			{
+				return (*this->values)[lhs] < (*this->values)[rhs];
+			}
+
+			_NODISCARD bool operator()(const probe & lhs, const size_type rhs) const
+			{
+				return lhs.value < (*this->values)[rhs];
+			}
+
+			_NODISCARD bool operator()(const size_type lhs, const probe & rhs) const
+			{
+				return (*this->values)[lhs] < rhs.value;
+			}
+		};
+
+		using index_type = std::set<size_type, position_compare>;
+
+	public:
+
+		/// <summary>
+		/// Creates an empty set
+		/// </summary>
+		_NODISCARD_CTOR ordered_set()
+			: values(), positions(position_compare{ &this->values })
+		{
+		}
+
+		/// <summary>
+		/// Copying or moving a set rebuilds its index, which has to refer to the own values
+		/// </summary>
+		_NODISCARD_CTOR ordered_set(const ordered_set & other)
+			: values(other.values), positions(position_compare{ &this->values })
+		{
+			this->adopt(other.positions);
+		}
+
+		_NODISCARD_CTOR ordered_set(ordered_set && other)
+			: values(std::move(other.values)), positions(position_compare{ &this->values })
+		{
+			this->adopt(other.positions);
+			other.clear();
+		}
+
+		ordered_set & operator = (const ordered_set & other)
+		{
+			if (this != &other)
+			{
+				this->values = other.values;
+				this->adopt(other.positions);
+			}
+
+			return *this;
+		}
+
+		ordered_set & operator = (ordered_set && other)
+		{
+			if (this != &other)
+			{
+				this->values = std::move(other.values);
+				this->adopt(other.positions);
+				other.clear();
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		/// Inserts the value unless an equal one is already stored
+		/// </summary>
+		/// <param name="value">the value to insert</param>
+		/// <returns>the position of the stored value and whether it has just been inserted</returns>
+		std::pair<size_type, bool> insert(const value_type & value)
+		{
+			const auto iterator = this->positions.lower_bound(probe{ value });
+			if (iterator != this->positions.end() && !(value < this->values[*iterator]))
+				return { *iterator, false };
+
+			// the new position gets compared by its value, which therefore has to be stored first
+			const size_type position = this->values.size();
+			this->values.push_back(value);
+			this->positions.emplace_hint(iterator, position);
+
+			return { position, true };
+		}
+
+		/// <summary>
+		/// Looks up the position of a value
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		/// <returns>the position of the stored value or npos</returns>
+		_NODISCARD size_type find(const value_type & value) const
+		{
+			const auto iterator = this->positions.find(probe{ value });
+			return iterator == this->positions.end() ? npos : *iterator;
+		}
+
+		/// <summary>
+		/// Checks whether an equal value is stored
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		_NODISCARD bool contains(const value_type & value) const
+		{
+			return this->find(value) != npos;
+		}
+
+		/// <summary>
+		/// Returns the value stored at a position, positions follow the insertion order
+		/// </summary>
+		_NODISCARD const value_type & operator [] (const size_type position) const
+		{
+			return this->values[position];
+		}
+
+		/// <summary>
+		/// Returns the number of stored values
+		/// </summary>
+		_NODISCARD size_type size() const
+		{
+			return this->values.size();
+		}
+
+		/// <summary>
+		/// Checks whether the set is empty
+		/// </summary>
+		_NODISCARD bool empty() const
+		{
+			return this->values.empty();
+		}
+
+		/// <summary>
+		/// Removes all values
+		/// </summary>
+		void clear()
+		{
+			this->positions.clear();
+			std::vector<value_type>().swap(this->values);
+		}
+
+	private:
+
+		/// <summary>
+		/// Rebuilds the index from another set's one, in linear time as the
+		/// positions are already sorted
+		/// </summary>
+		void adopt(const index_type & other)
+		{
+			this->positions = index_type(position_compare{ &this->values });
+
+			for (const size_type position : other)
+				this->positions.emplace_hint(this->positions.end(), position);
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		std::vector<value_type> values;
+		index_type              positions;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Opt-in policy to run expensive operators on multiple threads.
+	/// Inputs smaller than the threshold stay sequential since spawning
+	/// threads would cost more than it saves.
+	/// </summary>
+	struct parallel_policy
+	{
+		/// <summary>
+		/// number of threads to use, zero meaning one per hardware thread
+		/// </summary>
+		std::size_t thread_count = 0;
+
+		/// <summary>
+		/// minimum number of elements before any thread gets spawned
+		/// </summary>
+		std::size_t threshold = 1 << 16;
+
+		/// <summary>
+		/// Resolves the number of threads to use for an input of the given size
+		/// </summary>
+		/// <param name="size">the number of elements to process</param>
+		_NODISCARD std::size_t threads_for(const std::size_t size) const
+		{
+			if (size < this->threshold)
+				return 1;
+
+			const std::size_t threads = this->thread_count != 0
+				? this->thread_count
+				: std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+			return std::min(threads, std::max<std::size_t>(1, size));
+		}
+	};
+
+	/// <summary>
+	/// Default parallel policy
+	/// </summary>
+	inline constexpr parallel_policy parallel{};
+
+	/// <summary>
+	/// Policy describing a purely sequential execution
+	/// </summary>
+	inline constexpr parallel_policy sequential{ 1, 0 };
+
+	/// <summary>
+	/// Runs task(index) for every index in [0, task_count) on up to thread_count
+	/// threads, the calling thread included. The first exception thrown by a task
+	/// gets rethrown once all threads have finished. If a thread cannot be spawned
+	/// the calling thread runs its tasks instead.
+	/// </summary>
+	/// <param name="thread_count">the maximum number of threads to use</param>
+	/// <param name="task_count">the number of tasks to run</param>
+	/// <param name="task">the function to invoke with each task index</param>
+	template<typename TTask>
+	void parallel_for(const std::size_t thread_count, const std::size_t task_count, const TTask & task)
+	{
+		const std::size_t threads = std::max<std::size_t>(1, std::min(thread_count, task_count));
+
+		std::vector<std::exception_ptr> errors(threads);
+		const auto worker = [&](const std::size_t thread_index)
+		{
+			try
+			{
+				for (std::size_t index = thread_index; index < task_count; index += threads)
+					task(index);
+			}
+			catch (...)
+			{
+				errors[thread_index] = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+
+		// a thread which cannot be spawned gets its indices run on the calling thread
+		std::size_t spawned = 1;
+		try
+		{
+			for (; spawned < threads; ++spawned)
+				workers.emplace_back(worker, spawned);
+		}
+		catch (...)
+		{
+		}
+
+		for (std::size_t thread_index = spawned; thread_index < threads; ++thread_index)
+			worker(thread_index);
+
+		worker(0);
+
+		for (std::thread & thread : workers)
+			thread.join();
+
+		for (const std::exception_ptr & error : errors)
+		{
+			if (error)
+				std::rethrow_exception(error);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <optional>
+#include <functional>
+
+#include <linq/utils/hasher.hpp>
+#include <linq/utils/bloom_filter.hpp>
+#include <linq/utils/flat_hash_set.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// flat_hash_set with a Bloom filter in front of its lookups. Once the set
+	/// is queried while holding enough values to outgrow the caches, a blocked
+	/// Bloom filter gets built next to it, a negative answer of the filter
+	/// then skips the probe into the much larger table.
+	/// </summary>
+	template<typename TValue, typename THasher = hasher<TValue>, typename TEqual = std::equal_to<TValue>>
+	class prefiltered_set
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using value_type  = TValue;
+		using hasher_type = THasher;
+		using equal_type  = TEqual;
+		using set_type    = flat_hash_set<value_type, hasher_type, equal_type>;
+		using size_type   = typename set_type::size_type;
+
+		/// <summary>
+		/// Position returned by find if the value is not part of the set
+		/// </summary>
+		inline static constexpr size_type npos = set_type::npos;
+
+		/// <summary>
+		/// Number of values from which on lookups go through the filter
+		/// </summary>
+		inline static constexpr size_type prefilter_size = size_type(1) << 20;
+
+		/// <summary>
+		/// False positive rate the filter gets sized for
+		/// </summary>
+		inline static constexpr double prefilter_rate = 0.01;
+
+	public:
+
+		/// <summary>
+		/// Creates an empty set
+		/// </summary>
+		/// <param name="hash">the hash function</param>
+		/// <param name="equal">the equality comparison, has to agree with the hash function</param>
+		_NODISCARD_CTOR explicit prefiltered_set(const hasher_type & hash = hasher_type(), const equal_type & equal = equal_type())
+			: values(hash, equal), filter()
+		{
+		}
+
+		/// <summary>
+		/// Inserts the value unless an equal one is already stored
+		/// </summary>
+		/// <param name="value">the value to insert</param>
+		/// <returns>the position of the stored value and whether it has just been inserted</returns>
+		std::pair<size_type, bool> insert(const value_type & value)
+		{
+			const size_type hash = this->values.hash_function()(value);
+			const auto insertion_result = this->values.insert(value, hash);
+
+			if (insertion_result.second && this->filter)
+				this->filter->insert(hash);
+
+			return insertion_result;
+		}
+
+		/// <summary>
+		/// Looks up the position of a value
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		/// <returns>the position of the stored value or npos</returns>
+		_NODISCARD size_type find(const value_type & value) const
+		{
+			if (this->values.empty())
+				return npos;
+
+			if (!this->filter && this->values.size() >= prefilter_size)
+				this->build_filter();
+
+			const size_type hash = this->values.hash_function()(value);
+
+			if (this->filter && !this->filter->may_contain(hash))
+				return npos;
+
+			return this->values.find(value, hash);
+		}
+
+		/// <summary>
+		/// Checks whether an equal value is stored
+		/// </summary>
+		/// <param name="value">the value to look for</param>
+		_NODISCARD bool contains(const value_type & value) const
+		{
+			return this->find(value) != npos;
+		}
+
+		/// <summary>
+		/// Returns the value stored at a position, positions follow the insertion order
+		/// </summary>
+		_NODISCARD const value_type & operator [] (const size_type position) const
+		{
+			return this->values[position];
+		}
+
+		/// <summary>
+		/// Returns the number of stored values
+		/// </summary>
+		_NODISCARD size_type size() const
+		{
+			return this->values.size();
+		}
+
+		/// <summary>
+		/// Checks whether the set is empty
+		/// </summary>
+		_NODISCARD bool empty() const
+		{
+			return this->values.empty();
+		}
+
+		/// <summary>
+		/// Removes all values and releases the memory
+		/// </summary>
+		void clear()
+		{
+			this->values.clear();
+			this->filter.reset();
+		}
+
+	private:
+
+		void build_filter() const
+		{
+			// sized for twice the current values so later insertions keep the rate low
+			this->filter.emplace(this->values.size() * 2, prefilter_rate);
+
+			for (size_type position = 0; position < this->values.size(); ++position)
+				this->filter->insert(this->values.hash_function()(this->values[position]));
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		set_type                            values;
+		mutable std::optional<bloom_filter> filter;
+
+	};
+
+	/// <summary>
+	/// Set the probing operators (except_with_duplicates, intersect_with) use by
+	/// default: a prefiltered_set if the default hasher supports the value
+	/// type, an ordered_set otherwise. Operators inserting every value they
+	/// look up gain nothing from the filter and use default_set_t instead.
+	/// </summary>
+	template<typename TValue>
+	using default_probe_set_t = std::conditional_t<hashable_concept<TValue>, prefiltered_set<TValue>, ordered_set<TValue>>;
+
+}
\ No newline at end of file
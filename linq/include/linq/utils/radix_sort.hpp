@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Keys which can be turned into an order preserving unsigned integer
+	/// </summary>
+	template<typename TKey>
+	concept radix_key_concept =
+		((std::is_integral_v<TKey> || std::is_enum_v<TKey>) && (sizeof(TKey) == 1 || sizeof(TKey) == 2 || sizeof(TKey) == 4 || sizeof(TKey) == 8)) ||
+		std::is_same_v<TKey, float> ||
+		std::is_same_v<TKey, double>;
+
+	/// <summary>
+	/// Checks whether every key of an ordering chain supports radix sorting
+	/// </summary>
+	template<typename TKeyTuple>
+	inline constexpr bool is_radix_key_tuple_v = false;
+
+	template<typename... TKeys>
+	inline constexpr bool is_radix_key_tuple_v<std::tuple<TKeys...>> = (radix_key_concept<TKeys> && ...);
+
+	/// <summary>
+	/// Unsigned integer with the same width as TKey
+	/// </summary>
+	template<typename TKey>
+	using radix_bits_t =
+		std::conditional_t<sizeof(TKey) == 1, std::uint8_t,
+		std::conditional_t<sizeof(TKey) == 2, std::uint16_t,
+		std::conditional_t<sizeof(TKey) == 4, std::uint32_t, std::uint64_t>>>;
+
+	/// <summary>
+	/// Maps a key onto an unsigned integer so that comparing the integers
+	/// gives the same order as comparing the keys. Signed integers get
+	/// their sign bit flipped, negative floating-point numbers get all bits
+	/// flipped and positive ones only the sign bit.
+	/// </summary>
+	/// <param name="key">the key to convert</param>
+	/// <param name="ascending">false to invert the resulting order</param>
+	template<radix_key_concept TKey>
+	_NODISCARD radix_bits_t<TKey> to_radix_bits(const TKey key, const bool ascending)
+	{
+		using bits_type = radix_bits_t<TKey>;
+		constexpr bits_type sign_bit = bits_type(bits_type(1) << (sizeof(TKey) * 8 - 1));
+
+		bits_type bits;
+
+		if constexpr (std::is_floating_point_v<TKey>)
+		{
+			// -0.0 and +0.0 compare equal, they have to end up with the same bits
+			const TKey normalized = key == TKey(0) ? TKey(0) : key;
+			std::memcpy(&bits, &normalized, sizeof(bits));
+			bits = (bits & sign_bit) ? bits_type(~bits) : bits_type(bits | sign_bit);
+		}
+		else if constexpr (std::is_enum_v<TKey>)
+		{
+			return to_radix_bits(static_cast<std::underlying_type_t<TKey>>(key), ascending);
+		}
+		else if constexpr (std::is_signed_v<TKey>)
+		{
+			bits = bits_type(bits_type(key) ^ sign_bit);
+		}
+		else
+		{
+			bits = bits_type(key);
+		}
+
+		return ascending ? bits : bits_type(~bits);
+	}
+
+	/// <summary>
+	/// Runs all byte passes for a single key of the tuple
+	/// </summary>
+	template<std::size_t Index, typename TEntry>
+	void radix_sort_key(std::vector<TEntry> & entries, std::vector<TEntry> & scratch, const bool ascending)
+	{
+		using key_type  = std::tuple_element_t<Index, decltype(TEntry::key)>;
+		using bits_type = radix_bits_t<key_type>;
+
+		constexpr std::size_t digit_count = sizeof(bits_type);
+		constexpr std::size_t bucket_count = 256;
+
+		const std::size_t size = entries.size();
+
+		// count all digits in a single pass
+		std::vector<std::array<std::size_t, bucket_count>> histograms(digit_count);
+		for (const TEntry & entry : entries)
+		{
+			const bits_type bits = to_radix_bits(std::get<Index>(entry.key), ascending);
+
+			for (std::size_t digit = 0; digit < digit_count; ++digit)
+				++histograms[digit][(bits >> (digit * 8)) & 0xFF];
+		}
+
+		for (std::size_t digit = 0; digit < digit_count; ++digit)
+		{
+			auto & histogram = histograms[digit];
+
+			// every entry shares this byte, the pass would not change anything
+			const bits_type first_bits = to_radix_bits(std::get<Index>(entries.front().key), ascending);
+			if (histogram[(first_bits >> (digit * 8)) & 0xFF] == size)
+				continue;
+
+			std::size_t offset = 0;
+			for (std::size_t & count : histogram)
+			{
+				const std::size_t current = count;
+				count  = offset;
+				offset += current;
+			}
+
+			for (TEntry & entry : entries)
+			{
+				const bits_type bits = to_radix_bits(std::get<Index>(entry.key), ascending);
+				scratch[histogram[(bits >> (digit * 8)) & 0xFF]++] = std::move(entry);
+			}
+
+			entries.swap(scratch);
+		}
+	}
+
+	/// <summary>
+	/// Stable least-significant-digit radix sort on entries holding a tuple
+	/// of radix keys. Keys get processed from the last to the first one and
+	/// each key byte by byte, bytes that are equal for all entries are skipped.
+	/// </summary>
+	/// <param name="entries">the entries to sort, each exposing a key tuple named key</param>
+	/// <param name="directions">one flag per key, true meaning ascending</param>
+	template<typename TEntry, std::size_t KeyCount>
+	void radix_sort(std::vector<TEntry> & entries, const std::array<bool, KeyCount> & directions)
+	{
+		if (entries.empty())
+			return;
+
+		std::vector<TEntry> scratch(entries.size());
+
+		[&]<std::size_t... Indices>(std::index_sequence<Indices...>)
+		{
+			// least significant key first
+			(radix_sort_key<KeyCount - 1 - Indices>(entries, scratch, directions[KeyCount - 1 - Indices]), ...);
+		}(std::make_index_sequence<KeyCount>());
+	}
+
+}
\ No newline at end of file
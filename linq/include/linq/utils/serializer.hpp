@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <istream>
+#include <ostream>
+#include <concepts>
+#include <type_traits>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Writes values to and reads them back from binary streams. Operators
+	/// spilling to disk require a serializer for their value type.
+	/// Trivially copyable types and std::basic_string are supported out
+	/// of the box, other types can be added by specializing this template
+	/// with the same three static functions.
+	/// </summary>
+	template<typename TValue>
+	struct serializer;
+
+	template<typename TValue>
+		requires std::is_trivially_copyable_v<TValue>
+	struct serializer<TValue>
+	{
+		/// <summary>
+		/// Returns the number of bytes the value occupies once written
+		/// </summary>
+		_NODISCARD static std::size_t size(const TValue &)
+		{
+			return sizeof(TValue);
+		}
+
+		/// <summary>
+		/// Writes the value to the stream
+		/// </summary>
+		static void write(std::ostream & stream, const TValue & value)
+		{
+			stream.write(reinterpret_cast<const char *>(&value), sizeof(TValue));
+		}
+
+		/// <summary>
+		/// Reads a value from the stream, returns false at the end of the stream
+		/// </summary>
+		_NODISCARD static bool read(std::istream & stream, TValue & value)
+		{
+			return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(TValue)));
+		}
+	};
+
+	template<typename TChar, typename TTraits, typename TAllocator>
+	struct serializer<std::basic_string<TChar, TTraits, TAllocator>>
+	{
+		using string_type = std::basic_string<TChar, TTraits, TAllocator>;
+
+		/// <summary>
+		/// Returns the number of bytes the value occupies once written
+		/// </summary>
+		_NODISCARD static std::size_t size(const string_type & value)
+		{
+			return sizeof(std::size_t) + value.size() * sizeof(TChar);
+		}
+
+		/// <summary>
+		/// Writes the length followed by the characters
+		/// </summary>
+		static void write(std::ostream & stream, const string_type & value)
+		{
+			const std::size_t length = value.size();
+			stream.write(reinterpret_cast<const char *>(&length), sizeof(length));
+			stream.write(reinterpret_cast<const char *>(value.data()), length * sizeof(TChar));
+		}
+
+		/// <summary>
+		/// Reads a string from the stream, returns false at the end of the stream
+		/// </summary>
+		_NODISCARD static bool read(std::istream & stream, string_type & value)
+		{
+			std::size_t length = 0;
+			if (!stream.read(reinterpret_cast<char *>(&length), sizeof(length)))
+				return false;
+
+			value.resize(length);
+			return static_cast<bool>(stream.read(reinterpret_cast<char *>(value.data()), length * sizeof(TChar)));
+		}
+	};
+
+	/// <summary>
+	/// Types a serializer exists for
+	/// </summary>
+	template<typename TValue>
+	concept serializable_concept = std::is_default_constructible_v<TValue> && requires(const TValue & value, TValue & target, std::istream & input, std::ostream & output)
+	{
+		{ serializer<TValue>::size(value) } -> std::convertible_to<std::size_t>;
+		serializer<TValue>::write(output, value);
+		{ serializer<TValue>::read(input, target) } -> std::same_as<bool>;
+	};
+
+}
\ No newline at end of file
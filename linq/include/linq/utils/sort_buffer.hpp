@@ -0,0 +1,463 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+#include <linq/utils/parallel.hpp>
+#include <linq/utils/radix_sort.hpp>
+#include <linq/utils/string_sort.hpp>
+
+namespace linq
+{
+
+	template<typename TValue, typename TKey>
+	class sort_buffer
+	{
+	public:
+
+		/// <summary>
+		/// Type definitions
+		/// </summary>
+		using value_type = TValue;
+		using key_type   = TKey;
+		using size_type  = std::size_t;
+
+		/// <summary>
+		/// A sort key together with the position of its
+		/// value inside the materialized buffer
+		/// </summary>
+		struct entry
+		{
+			key_type  key;
+			size_type index;
+		};
+
+		using value_list_type = std::vector<value_type>;
+		using entry_list_type = std::vector<entry>;
+
+	public:
+
+		/// <summary>
+		/// Appends a value, its key gets extracted by extract_keys once
+		/// all values of the buffer have been appended
+		/// </summary>
+		/// <param name="value">the value to store</param>
+		void push_back(const value_type & value)
+		{
+			this->values.push_back(value);
+		}
+
+		/// <summary>
+		/// Extracts the keys of all values appended since the last call. The keys
+		/// are taken from the stored values, so keys viewing into their value
+		/// (string_view, span, pointers) stay valid. No value may be appended
+		/// afterwards until the buffer gets cleared.
+		/// </summary>
+		/// <param name="select_key">extracts the sort key of a value</param>
+		template<typename TSelectKey>
+		void extract_keys(const TSelectKey & select_key)
+		{
+			this->entries.reserve(this->values.size());
+
+			for (size_type index = this->entries.size(); index < this->values.size(); ++index)
+				this->entries.push_back(entry{ select_key(this->values[index]), index });
+		}
+
+		/// <summary>
+		/// Appends a value but only keeps the count smallest entries seen so far,
+		/// evicting the largest one through a bounded max-heap. Ties are resolved
+		/// by arrival so the result stays stable.
+		/// </summary>
+		/// <param name="value">the value to store</param>
+		/// <param name="select_key">extracts the sort key of a value</param>
+		/// <param name="count">the maximum number of entries to keep</param>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		template<typename TSelectKey, typename TCompare>
+		void push_bounded(const value_type & value, const TSelectKey & select_key, const size_type count, const TCompare & compare)
+		{
+			const size_type sequence = this->pushed++;
+			const auto before = this->make_bounded_compare(compare);
+
+			if (this->entries.size() < count)
+			{
+				const bool relocates = this->values.size() == this->values.capacity();
+
+				this->values.push_back(value);
+				this->sequences.push_back(sequence);
+
+				// growing moved every stored value, keys viewing into them have to be extracted again
+				if (relocates)
+				{
+					for (entry & current : this->entries)
+						current.key = select_key(this->values[current.index]);
+				}
+
+				this->entries.push_back(entry{ select_key(this->values.back()), this->values.size() - 1 });
+				std::push_heap(this->entries.begin(), this->entries.end(), before);
+				return;
+			}
+
+			// the new value arrived last, so it only wins if its key is strictly smaller
+			if (this->entries.empty() || !compare(select_key(value), this->entries.front().key))
+				return;
+
+			std::pop_heap(this->entries.begin(), this->entries.end(), before);
+
+			entry & evicted = this->entries.back();
+			this->values[evicted.index]    = value;
+			this->sequences[evicted.index] = sequence;
+			evicted.key                    = select_key(this->values[evicted.index]);
+
+			std::push_heap(this->entries.begin(), this->entries.end(), before);
+		}
+
+		/// <summary>
+		/// Turns the heap built by push_bounded into sorted order
+		/// </summary>
+		/// <param name="compare">the ordering passed to push_bounded</param>
+		template<typename TCompare>
+		void sort_bounded(const TCompare & compare)
+		{
+			std::sort_heap(this->entries.begin(), this->entries.end(), this->make_bounded_compare(compare));
+		}
+
+		/// <summary>
+		/// Arranges the key/index array as a heap yielding the smallest entry first,
+		/// equal keys are yielded in the order they were pushed
+		/// </summary>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		template<typename TCompare>
+		void make_heap(const TCompare & compare)
+		{
+			std::make_heap(this->entries.begin(), this->entries.end(), make_heap_compare(compare));
+		}
+
+		/// <summary>
+		/// Moves the smallest entry of the heap [0, heap_size) to position heap_size - 1
+		/// </summary>
+		/// <param name="heap_size">the current size of the heap</param>
+		/// <param name="compare">the ordering passed to make_heap</param>
+		template<typename TCompare>
+		void pop_heap(const size_type heap_size, const TCompare & compare)
+		{
+			std::pop_heap(this->entries.begin(), this->entries.begin() + heap_size, make_heap_compare(compare));
+		}
+
+		/// <summary>
+		/// Moves the entry which a stable sort would put at rank into that
+		/// position through introselect, in expected linear time. Entries
+		/// before it are not greater, entries after it not smaller.
+		/// </summary>
+		/// <param name="rank">the position to select, has to be less than size()</param>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		template<typename TCompare>
+		void select(const size_type rank, const TCompare & compare)
+		{
+			std::nth_element(this->entries.begin(), this->entries.begin() + rank, this->entries.end(), [&compare](const entry & lhs, const entry & rhs)
+			{
+				if (compare(lhs.key, rhs.key))
+					return true;
+
+				if (compare(rhs.key, lhs.key))
+					return false;
+
+				return lhs.index < rhs.index;
+			});
+		}
+
+		/// <summary>
+		/// Stable sorts the key/index array in place. The values
+		/// themselves never move.
+		/// </summary>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		template<typename TCompare>
+		void sort(const TCompare & compare)
+		{
+			std::stable_sort(this->entries.begin(), this->entries.end(), [&compare](const entry & lhs, const entry & rhs)
+			{
+				return compare(lhs.key, rhs.key);
+			});
+		}
+
+		/// <summary>
+		/// Stable sorts the key/index array using a parallel merge sort.
+		/// Chunks get sorted on their own threads, afterwards runs are merged
+		/// pairwise where each merge is split into independent pieces so
+		/// every round keeps all threads busy.
+		/// </summary>
+		/// <param name="compare">a strict weak ordering on the keys</param>
+		/// <param name="policy">the parallel policy to respect</param>
+		template<typename TCompare>
+		void sort(const TCompare & compare, const parallel_policy & policy)
+		{
+			const size_type size    = this->entries.size();
+			const size_type threads = policy.threads_for(size);
+
+			if constexpr (std::is_default_constructible_v<key_type>)
+			{
+				if (threads > 1)
+				{
+					this->parallel_sort(compare, threads);
+					return;
+				}
+			}
+
+			this->sort(compare);
+		}
+
+		/// <summary>
+		/// Stable sorts the key/index array with an LSD radix sort. Only
+		/// available for keys made of integers, enums and floating-point numbers.
+		/// Tiny inputs and multi-threaded policies fall back to the comparison sort.
+		/// </summary>
+		/// <param name="directions">one flag per key, true meaning ascending</param>
+		/// <param name="compare">the ordering used by the fallback</param>
+		/// <param name="policy">the parallel policy to respect</param>
+		template<std::size_t KeyCount, typename TCompare>
+		void radix_sort(const std::array<bool, KeyCount> & directions, const TCompare & compare, const parallel_policy & policy)
+		{
+			static_assert(is_radix_key_tuple_v<key_type>, "radix_sort requires integral, enum or floating-point keys");
+
+			// the histograms only pay off once there are enough entries
+			constexpr size_type minimum_size = 256;
+
+			if (this->entries.size() < minimum_size || policy.threads_for(this->entries.size()) > 1)
+			{
+				this->sort(compare, policy);
+				return;
+			}
+
+			linq::radix_sort(this->entries, directions);
+		}
+
+		/// <summary>
+		/// Stable sorts the key/index array with a multikey quicksort. Only
+		/// available for a single std::string or std::string_view key.
+		/// Tiny inputs and multi-threaded policies fall back to the comparison sort.
+		/// </summary>
+		/// <param name="ascending">the sorting direction</param>
+		/// <param name="compare">the ordering used by the fallback</param>
+		/// <param name="policy">the parallel policy to respect</param>
+		template<typename TCompare>
+		void string_sort(const bool ascending, const TCompare & compare, const parallel_policy & policy)
+		{
+			static_assert(is_string_key_tuple_v<key_type>, "string_sort requires a single string key");
+
+			// tiny inputs are faster to sort by plain comparisons
+			constexpr size_type minimum_size = 64;
+
+			if (this->entries.size() < minimum_size || policy.threads_for(this->entries.size()) > 1)
+			{
+				this->sort(compare, policy);
+				return;
+			}
+
+			linq::string_sort(this->entries, ascending);
+		}
+
+		/// <summary>
+		/// Returns the value at the given sorted position
+		/// </summary>
+		/// <param name="position">the position inside the sorted order</param>
+		_NODISCARD const value_type & operator [] (const size_type position) const
+		{
+			return this->values[this->entries[position].index];
+		}
+
+		/// <summary>
+		/// Removes all values and keys
+		/// </summary>
+		void clear()
+		{
+			this->values.clear();
+			this->entries.clear();
+		}
+
+		/// <summary>
+		/// Returns the number of values stored
+		/// </summary>
+		_NODISCARD size_type size() const
+		{
+			return this->entries.size();
+		}
+
+	private:
+
+		/// <summary>
+		/// A contiguous run of sorted entries
+		/// </summary>
+		struct run
+		{
+			size_type begin;
+			size_type end;
+		};
+
+		/// <summary>
+		/// A piece of a merge writing to [output, output + (lhs_end - lhs_begin) + (rhs_end - rhs_begin))
+		/// </summary>
+		struct merge_task
+		{
+			size_type lhs_begin;
+			size_type lhs_end;
+			size_type rhs_begin;
+			size_type rhs_end;
+			size_type output;
+		};
+
+		template<typename TCompare>
+		void parallel_sort(const TCompare & compare, const size_type threads)
+		{
+			const auto before = [&compare](const entry & lhs, const entry & rhs)
+			{
+				return compare(lhs.key, rhs.key);
+			};
+
+			const size_type size = this->entries.size();
+
+			// sort one chunk per thread
+			std::vector<run> runs(threads);
+			for (size_type index = 0; index < threads; ++index)
+				runs[index] = run{ size * index / threads, size * (index + 1) / threads };
+
+			parallel_for(threads, threads, [&](const size_type index)
+			{
+				std::stable_sort(this->entries.begin() + runs[index].begin, this->entries.begin() + runs[index].end, before);
+			});
+
+			// merge pairs of runs back and forth between both buffers
+			entry_list_type scratch(size);
+			entry_list_type * source      = &this->entries;
+			entry_list_type * destination = &scratch;
+
+			while (runs.size() > 1)
+			{
+				std::vector<merge_task> tasks;
+				std::vector<run>        merged;
+
+				const size_type pieces = std::max<size_type>(1, threads / (runs.size() / 2));
+
+				for (size_type index = 0; index < runs.size(); index += 2)
+				{
+					const run lhs = runs[index];
+					const run rhs = index + 1 < runs.size() ? runs[index + 1] : run{ lhs.end, lhs.end };
+
+					const size_type total = (lhs.end - lhs.begin) + (rhs.end - rhs.begin);
+					for (size_type piece = 0; piece < pieces; ++piece)
+					{
+						const size_type first = total * piece / pieces;
+						const size_type last  = total * (piece + 1) / pieces;
+
+						const size_type lhs_first = this->co_rank(*source, lhs, rhs, first, before);
+						const size_type lhs_last  = this->co_rank(*source, lhs, rhs, last, before);
+
+						tasks.push_back(merge_task{
+							lhs.begin + lhs_first,
+							lhs.begin + lhs_last,
+							rhs.begin + (first - lhs_first),
+							rhs.begin + (last - lhs_last),
+							lhs.begin + first
+						});
+					}
+
+					merged.push_back(run{ lhs.begin, rhs.end });
+				}
+
+				parallel_for(threads, tasks.size(), [&](const size_type index)
+				{
+					const merge_task & task = tasks[index];
+					std::merge(
+						std::make_move_iterator(source->begin() + task.lhs_begin),
+						std::make_move_iterator(source->begin() + task.lhs_end),
+						std::make_move_iterator(source->begin() + task.rhs_begin),
+						std::make_move_iterator(source->begin() + task.rhs_end),
+						destination->begin() + task.output,
+						before
+					);
+				});
+
+				std::swap(source, destination);
+				runs = std::move(merged);
+			}
+
+			if (source != &this->entries)
+				this->entries = std::move(*source);
+		}
+
+		/// <summary>
+		/// Determines how many elements of lhs a stable merge of lhs and rhs
+		/// consumes before writing the given output position
+		/// </summary>
+		template<typename TBefore>
+		_NODISCARD static size_type co_rank(const entry_list_type & source, const run lhs, const run rhs, const size_type position, const TBefore & before)
+		{
+			const size_type lhs_size = lhs.end - lhs.begin;
+			const size_type rhs_size = rhs.end - rhs.begin;
+
+			size_type low  = position > rhs_size ? position - rhs_size : 0;
+			size_type high = std::min(position, lhs_size);
+
+			while (low < high)
+			{
+				const size_type lhs_taken = low + (high - low) / 2;
+				const size_type rhs_taken = position - lhs_taken;
+
+				// equal keys are taken from lhs first, so lhs[lhs_taken] still belongs in front of rhs[rhs_taken - 1]
+				if (rhs_taken > 0 && !before(source[rhs.begin + rhs_taken - 1], source[lhs.begin + lhs_taken]))
+					low = lhs_taken + 1;
+				else
+					high = lhs_taken;
+			}
+
+			return low;
+		}
+
+		/// <summary>
+		/// Orders entries for a min-heap, ties are resolved by the push order
+		/// </summary>
+		template<typename TCompare>
+		_NODISCARD static auto make_heap_compare(const TCompare & compare)
+		{
+			return [&compare](const entry & lhs, const entry & rhs)
+			{
+				if (compare(rhs.key, lhs.key))
+					return true;
+
+				if (compare(lhs.key, rhs.key))
+					return false;
+
+				return rhs.index < lhs.index;
+			};
+		}
+
+		template<typename TCompare>
+		_NODISCARD auto make_bounded_compare(const TCompare & compare) const
+		{
+			return [this, &compare](const entry & lhs, const entry & rhs)
+			{
+				if (compare(lhs.key, rhs.key))
+					return true;
+
+				if (compare(rhs.key, lhs.key))
+					return false;
+
+				return this->sequences[lhs.index] < this->sequences[rhs.index];
+			};
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		value_list_type        values;
+		entry_list_type        entries;
+		std::vector<size_type> sequences;
+		size_type              pushed = 0;
+
+	};
+
+}
\ No newline at end of file
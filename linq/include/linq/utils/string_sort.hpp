@@ -0,0 +1,246 @@
+#pragma once
+
+#include <tuple>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+namespace linq
+{
+
+	/// <summary>
+	/// Keys which get sorted byte by byte
+	/// </summary>
+	template<typename TKey>
+	concept string_key_concept = std::is_same_v<TKey, std::string> || std::is_same_v<TKey, std::string_view>;
+
+	/// <summary>
+	/// Checks whether an ordering chain consists of a single string key
+	/// </summary>
+	template<typename TKeyTuple>
+	inline constexpr bool is_string_key_tuple_v = false;
+
+	template<string_key_concept TKey>
+	inline constexpr bool is_string_key_tuple_v<std::tuple<TKey>> = true;
+
+	/// <summary>
+	/// Eight bytes of a string starting at a certain depth, packed big-endian
+	/// so that comparing the words compares the bytes. The length tells how
+	/// many of those bytes exist, a string ending inside the word sorts
+	/// before a longer one with the same bytes.
+	/// </summary>
+	struct string_sort_word
+	{
+		std::uint64_t bytes;
+		std::uint32_t length;
+
+		_NODISCARD bool operator == (const string_sort_word & other) const
+		{
+			return this->bytes == other.bytes && this->length == other.length;
+		}
+
+		_NODISCARD bool operator < (const string_sort_word & other) const
+		{
+			return this->bytes < other.bytes || (this->bytes == other.bytes && this->length < other.length);
+		}
+	};
+
+	/// <summary>
+	/// A string key to be sorted, referencing the entry it belongs to and
+	/// caching the word at the current depth to avoid touching the string
+	/// during partitioning
+	/// </summary>
+	struct string_sort_item
+	{
+		const char *     data;
+		std::size_t      size;
+		std::size_t      position;
+		string_sort_word word;
+	};
+
+	/// <summary>
+	/// Number of bytes compared at once
+	/// </summary>
+	inline constexpr std::size_t string_sort_word_size = sizeof(std::uint64_t);
+
+	/// <summary>
+	/// Loads the word starting at depth. Descending sorts invert the word
+	/// so that the partitioning itself never has to know the direction.
+	/// </summary>
+	_NODISCARD inline string_sort_word load_string_sort_word(const char * data, const std::size_t size, const std::size_t depth, const bool ascending)
+	{
+		const std::size_t length = std::min(size - depth, string_sort_word_size);
+
+		std::uint64_t bytes = 0;
+		for (std::size_t offset = 0; offset < string_sort_word_size; ++offset)
+		{
+			bytes <<= 8;
+
+			if (offset < length)
+				bytes |= static_cast<unsigned char>(data[depth + offset]);
+		}
+
+		if (ascending)
+			return string_sort_word{ bytes, static_cast<std::uint32_t>(length) };
+
+		return string_sort_word{ ~bytes, static_cast<std::uint32_t>(string_sort_word_size - length) };
+	}
+
+	/// <summary>
+	/// Checks whether the strings holding this word end within it
+	/// </summary>
+	_NODISCARD inline bool is_final_string_sort_word(const string_sort_word & word, const bool ascending)
+	{
+		return ascending ? word.length < string_sort_word_size : word.length > 0;
+	}
+
+	/// <summary>
+	/// Orders two items whose bytes before depth are known to be equal and whose
+	/// cached words belong to depth, equal strings keep their original order
+	/// </summary>
+	_NODISCARD inline bool string_sort_before(const string_sort_item & lhs, const string_sort_item & rhs, const std::size_t depth, const bool ascending)
+	{
+		string_sort_word lhs_word = lhs.word;
+		string_sort_word rhs_word = rhs.word;
+
+		for (std::size_t offset = depth;; offset += string_sort_word_size)
+		{
+			if (!(lhs_word == rhs_word))
+				return lhs_word < rhs_word;
+
+			if (is_final_string_sort_word(lhs_word, ascending))
+				return lhs.position < rhs.position;
+
+			lhs_word = load_string_sort_word(lhs.data, lhs.size, offset + string_sort_word_size, ascending);
+			rhs_word = load_string_sort_word(rhs.data, rhs.size, offset + string_sort_word_size, ascending);
+		}
+	}
+
+	/// <summary>
+	/// Stable multikey quicksort (Bentley and Sedgewick) on the items, working
+	/// on eight bytes at a time. Each partitioning step only looks at the cached
+	/// word of every item, so shared prefixes are scanned once instead of once
+	/// per comparison.
+	/// </summary>
+	/// <param name="items">the items to sort, their words loaded at depth zero</param>
+	/// <param name="ascending">the sorting direction</param>
+	inline void multikey_quicksort(std::vector<string_sort_item> & items, const bool ascending)
+	{
+		// below this size an insertion sort is cheaper than partitioning
+		constexpr std::size_t insertion_sort_size = 16;
+
+		struct partition
+		{
+			std::size_t begin;
+			std::size_t end;
+			std::size_t depth;
+		};
+
+		std::vector<partition> pending{ partition{ 0, items.size(), 0 } };
+
+		while (!pending.empty())
+		{
+			const partition current = pending.back();
+			pending.pop_back();
+
+			if (current.end - current.begin < 2)
+				continue;
+
+			if (current.end - current.begin <= insertion_sort_size)
+			{
+				for (std::size_t index = current.begin + 1; index < current.end; ++index)
+				{
+					const string_sort_item item = items[index];
+
+					std::size_t target = index;
+					while (target > current.begin && string_sort_before(item, items[target - 1], current.depth, ascending))
+					{
+						items[target] = items[target - 1];
+						--target;
+					}
+
+					items[target] = item;
+				}
+
+				continue;
+			}
+
+			// median of three as pivot
+			const string_sort_word first  = items[current.begin].word;
+			const string_sort_word middle = items[current.begin + (current.end - current.begin) / 2].word;
+			const string_sort_word last   = items[current.end - 1].word;
+			const string_sort_word pivot  = std::max(std::min(first, middle), std::min(std::max(first, middle), last));
+
+			// three-way partition: [begin, less) < pivot, [less, greater) == pivot, [greater, end) > pivot
+			std::size_t less    = current.begin;
+			std::size_t index   = current.begin;
+			std::size_t greater = current.end;
+
+			while (index < greater)
+			{
+				const string_sort_word & word = items[index].word;
+
+				if (word < pivot)
+					std::swap(items[less++], items[index++]);
+				else if (pivot < word)
+					std::swap(items[index], items[--greater]);
+				else
+					++index;
+			}
+
+			pending.push_back(partition{ current.begin, less, current.depth });
+			pending.push_back(partition{ greater, current.end, current.depth });
+
+			if (is_final_string_sort_word(pivot, ascending))
+			{
+				// every string in the middle ended within this word, they are equal
+				std::sort(items.begin() + less, items.begin() + greater, [](const string_sort_item & lhs, const string_sort_item & rhs)
+				{
+					return lhs.position < rhs.position;
+				});
+			}
+			else
+			{
+				const std::size_t depth = current.depth + string_sort_word_size;
+
+				for (std::size_t position = less; position < greater; ++position)
+					items[position].word = load_string_sort_word(items[position].data, items[position].size, depth, ascending);
+
+				pending.push_back(partition{ less, greater, depth });
+			}
+		}
+	}
+
+	/// <summary>
+	/// Stable sorts entries holding a single string key
+	/// </summary>
+	/// <param name="entries">the entries to sort, each exposing a key tuple named key</param>
+	/// <param name="ascending">the sorting direction</param>
+	template<typename TEntry>
+	void string_sort(std::vector<TEntry> & entries, const bool ascending)
+	{
+		std::vector<string_sort_item> items;
+		items.reserve(entries.size());
+
+		for (std::size_t position = 0; position < entries.size(); ++position)
+		{
+			const std::string_view key = std::get<0>(entries[position].key);
+			items.push_back(string_sort_item{ key.data(), key.size(), position, load_string_sort_word(key.data(), key.size(), 0, ascending) });
+		}
+
+		multikey_quicksort(items, ascending);
+
+		std::vector<TEntry> sorted;
+		sorted.reserve(entries.size());
+
+		for (const string_sort_item & item : items)
+			sorted.push_back(std::move(entries[item.position]));
+
+		entries.swap(sorted);
+	}
+
+}
\ No newline at end of file
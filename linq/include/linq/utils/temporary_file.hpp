@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <random>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+#include <linq/utils/exceptions.hpp>
+
+namespace linq
+{
+
+	/// <summary>
+	/// A uniquely named file inside a directory which gets deleted
+	/// as soon as the object is destroyed
+	/// </summary>
+	class temporary_file
+	{
+	public:
+
+		/// <summary>
+		/// Creates an empty temporary file
+		/// </summary>
+		/// <param name="directory">the directory to create the file in, empty meaning the system's temporary directory</param>
+		_NODISCARD_CTOR explicit temporary_file(const std::filesystem::path & directory)
+			: path(make_path(directory))
+		{
+			std::ofstream stream(this->path, std::ios::binary | std::ios::trunc);
+			if (!stream)
+				throw io_exception();
+		}
+
+		temporary_file(const temporary_file &) = delete;
+		temporary_file & operator = (const temporary_file &) = delete;
+
+		~temporary_file()
+		{
+			std::error_code error;
+			std::filesystem::remove(this->path, error);
+		}
+
+		/// <summary>
+		/// Opens the file for writing, discarding its previous content
+		/// </summary>
+		_NODISCARD std::ofstream open_write() const
+		{
+			std::ofstream stream(this->path, std::ios::binary | std::ios::trunc);
+			if (!stream)
+				throw io_exception();
+
+			return stream;
+		}
+
+		/// <summary>
+		/// Opens the file for reading
+		/// </summary>
+		_NODISCARD std::ifstream open_read() const
+		{
+			std::ifstream stream(this->path, std::ios::binary);
+			if (!stream)
+				throw io_exception();
+
+			return stream;
+		}
+
+		/// <summary>
+		/// Returns the location of the file
+		/// </summary>
+		_NODISCARD const std::filesystem::path & get_path() const
+		{
+			return this->path;
+		}
+
+	private:
+
+		_NODISCARD static std::filesystem::path make_path(const std::filesystem::path & directory)
+		{
+			static std::atomic<unsigned long long> counter{ 0 };
+
+			const std::filesystem::path base = directory.empty() ? std::filesystem::temp_directory_path() : directory;
+			const unsigned long long unique  = (static_cast<unsigned long long>(std::random_device()()) << 32) ^ counter++;
+
+			return base / ("linq-" + std::to_string(unique) + ".tmp");
+		}
+
+	private:
+
+		/// <summary>
+		/// Member attributes
+		/// </summary>
+
+		std::filesystem::path path;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "test.hpp"
+
+namespace
+{
+
+	struct sale
+	{
+		int key;
+		int amount;
+	};
+
+	std::vector<sale> make_sales(const std::size_t count, const std::size_t distinct_keys)
+	{
+		std::vector<sale> sales(count);
+		for (sale & value : sales)
+			value = sale{ static_cast<int>(linq::tests::random_below(distinct_keys)), static_cast<int>(linq::tests::random_below(1000)) };
+
+		return sales;
+	}
+
+	/// <summary>
+	/// Groups in first-seen key order, folding every group in input order
+	/// </summary>
+	template<typename TKey, typename TState, typename TKeySelector, typename TFold>
+	std::vector<std::pair<TKey, TState>> reference_aggregate(const std::vector<sale> & sales, const TKeySelector & select_key, const TState & seed, const TFold & fold)
+	{
+		std::vector<std::pair<TKey, TState>> groups;
+		std::unordered_map<TKey, std::size_t> positions;
+
+		for (const sale & value : sales)
+		{
+			const TKey key = select_key(value);
+			const auto [position, inserted] = positions.emplace(key, groups.size());
+
+			if (inserted)
+				groups.emplace_back(key, seed);
+
+			groups[position->second].second = fold(groups[position->second].second, value);
+		}
+
+		return groups;
+	}
+
+	template<typename TValue>
+	std::vector<TValue> reference_distinct(const std::vector<TValue> & values)
+	{
+		std::vector<TValue> result;
+		std::unordered_set<TValue> seen;
+
+		for (const TValue & value : values)
+		{
+			if (seen.insert(value).second)
+				result.push_back(value);
+		}
+
+		return result;
+	}
+
+	// neither fold is commutative, so the folding order gets checked as well
+	const auto hash_fold = [](const unsigned long long state, const sale & value) { return state * 31 + value.amount; };
+
+	const auto text_fold = [](std::string state, const sale & value)
+	{
+		if (state.size() < 16)
+			state += static_cast<char>('a' + value.amount % 26);
+
+		return state;
+	};
+
+	const auto int_key = [](const sale & value) { return value.key; };
+
+	const auto string_key = [](const sale & value) { return "key" + std::to_string(value.key); };
+
+}
+
+LINQ_TEST(group_aggregate_matches_reference)
+{
+	const std::vector<sale> sales = make_sales(5000, 300);
+
+	LINQ_CHECK(linq::from(sales).group_aggregate(int_key, 7ull, hash_fold).to_vector() == reference_aggregate<int>(sales, int_key, 7ull, hash_fold));
+	LINQ_CHECK(linq::from(sales).group_aggregate(string_key, std::string(), text_fold).to_vector() == reference_aggregate<std::string>(sales, string_key, std::string(), text_fold));
+}
+
+LINQ_TEST(spilling_group_aggregate_matches_in_memory)
+{
+	for (const std::size_t distinct_keys : { 1, 100, 3000 })
+	{
+		const std::vector<sale> sales = make_sales(5000, distinct_keys);
+
+		const auto hashed   = reference_aggregate<int>(sales, int_key, 7ull, hash_fold);
+		const auto textual  = reference_aggregate<std::string>(sales, string_key, std::string(), text_fold);
+
+		for (const std::size_t budget : { std::size_t(1), std::size_t(64), std::size_t(4096), std::size_t(1) << 30 })
+		{
+			linq::tests::scratch_directory directory;
+			const linq::external_hash_policy policy{ budget, directory.path };
+
+			LINQ_CHECK(linq::from(sales).group_aggregate(int_key, 7ull, hash_fold, policy).to_vector() == hashed);
+			LINQ_CHECK(linq::from(sales).group_aggregate(string_key, std::string(), text_fold, policy).to_vector() == textual);
+			LINQ_CHECK(directory.empty());
+		}
+	}
+}
+
+LINQ_TEST(spilling_distinct_matches_in_memory)
+{
+	std::vector<int>         numbers;
+	std::vector<std::string> strings;
+
+	for (const sale & value : make_sales(5000, 3000))
+	{
+		numbers.push_back(value.key * 7);
+		strings.push_back("value" + std::to_string(value.key));
+	}
+
+	for (const std::size_t budget : { std::size_t(1), std::size_t(64), std::size_t(4096), std::size_t(1) << 30 })
+	{
+		linq::tests::scratch_directory directory;
+		const linq::external_hash_policy policy{ budget, directory.path };
+
+		LINQ_CHECK(linq::from(numbers).distinct(policy).to_vector() == reference_distinct(numbers));
+		LINQ_CHECK(linq::from(strings).distinct(policy).to_vector() == reference_distinct(strings));
+		LINQ_CHECK(directory.empty());
+	}
+}
+
+LINQ_TEST(spilling_stops_early_without_leaking_files)
+{
+	const std::vector<sale> sales = make_sales(2000, 2000);
+
+	linq::tests::scratch_directory directory;
+
+	{
+		const auto first = linq::from(sales).group_aggregate(int_key, 7ull, hash_fold, linq::external_hash_policy{ 1, directory.path }).take(3).to_vector();
+		LINQ_CHECK(first.size() == 3);
+		LINQ_CHECK(first.front().first == sales.front().key);
+	}
+
+	LINQ_CHECK(directory.empty());
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "test.hpp"
+
+namespace
+{
+
+	struct order
+	{
+		int customer;
+		int id;
+	};
+
+	struct customer
+	{
+		long long   id;
+		std::string name;
+	};
+
+	std::vector<order> make_orders(const std::size_t count, const std::size_t customers)
+	{
+		std::vector<order> orders(count);
+		for (std::size_t index = 0; index < count; ++index)
+			orders[index] = order{ static_cast<int>(linq::tests::random_below(customers)), static_cast<int>(index) };
+
+		return orders;
+	}
+
+	std::vector<customer> make_customers(const std::size_t count, const std::size_t ids)
+	{
+		std::vector<customer> customers(count);
+		for (std::size_t index = 0; index < count; ++index)
+			customers[index] = customer{ static_cast<long long>(linq::tests::random_below(ids)), "customer" + std::to_string(index) };
+
+		return customers;
+	}
+
+	using match = std::pair<int, std::string>;
+
+	/// <summary>
+	/// Every matching pair, in lhs order and then rhs order. Orders without
+	/// any customer get a single "-" entry if left is set.
+	/// </summary>
+	std::vector<match> reference_join(const std::vector<order> & orders, const std::vector<customer> & customers, const bool left)
+	{
+		std::vector<match> result;
+
+		for (const order & lhs : orders)
+		{
+			bool matched = false;
+
+			for (const customer & rhs : customers)
+			{
+				if (lhs.customer == rhs.id)
+				{
+					result.emplace_back(lhs.id, rhs.name);
+					matched = true;
+				}
+			}
+
+			if (left && !matched)
+				result.emplace_back(lhs.id, "-");
+		}
+
+		return result;
+	}
+
+	const auto order_id    = [](const order & value) { return static_cast<long long>(value.customer); };
+	const auto customer_id = [](const customer & value) { return value.id; };
+	const auto combine     = [](const order & lhs, const customer & rhs) { return match(lhs.id, rhs.name); };
+
+}
+
+LINQ_TEST(hash_join_matches_nested_loop)
+{
+	for (const std::size_t customers : { 0, 1, 50, 3000 })
+	{
+		const std::vector<order>    orders = make_orders(3000, 100);
+		const std::vector<customer> people = make_customers(customers, 150);
+
+		std::vector<match> expected = reference_join(orders, people, false);
+		LINQ_CHECK(linq::from(orders).join(linq::from(people), order_id, customer_id, combine).to_vector() == expected);
+
+		// building on the lhs changes the order of the results, not the results
+		std::vector<match> swapped = linq::from(orders).join(linq::from(people), order_id, customer_id, combine, linq::join_build_side::lhs).to_vector();
+		std::sort(swapped.begin(), swapped.end());
+		std::sort(expected.begin(), expected.end());
+		LINQ_CHECK(swapped == expected);
+	}
+}
+
+LINQ_TEST(hash_join_converts_lhs_ids_to_the_rhs_id_type)
+{
+	// neither hashable nor comparable, only convertible to the rhs id type
+	struct order_key
+	{
+		int value;
+		operator long long() const { return this->value; }
+	};
+
+	const auto order_key_id = [](const order & value) { return order_key{ value.customer }; };
+
+	const std::vector<order>    orders = make_orders(2000, 100);
+	const std::vector<customer> people = make_customers(500, 150);
+
+	std::vector<match> expected = reference_join(orders, people, false);
+	LINQ_CHECK(linq::from(orders).join(linq::from(people), order_key_id, customer_id, combine).to_vector() == expected);
+
+	std::vector<match> swapped = linq::from(orders).join(linq::from(people), order_key_id, customer_id, combine, linq::join_build_side::lhs).to_vector();
+	std::sort(swapped.begin(), swapped.end());
+	std::sort(expected.begin(), expected.end());
+	LINQ_CHECK(swapped == expected);
+}
+
+LINQ_TEST(parallel_join_matches_sequential_join)
+{
+	const std::vector<order>    orders = make_orders(200000, 20000);
+	const std::vector<customer> people = make_customers(30000, 25000);
+
+	const auto sequential = linq::from(orders).join(linq::from(people), order_id, customer_id, combine).to_vector();
+
+	for (const std::size_t threads : { 1, 4, 7 })
+		LINQ_CHECK(linq::from(orders).join(linq::from(people), order_id, customer_id, combine, linq::parallel_policy{ threads, 0 }).to_vector() == sequential);
+}
+
+LINQ_TEST(merge_join_matches_hash_join_on_sorted_inputs)
+{
+	std::vector<order>    orders = make_orders(3000, 200);
+	std::vector<customer> people = make_customers(400, 250);
+
+	std::stable_sort(orders.begin(), orders.end(), [](const order & lhs, const order & rhs) { return lhs.customer < rhs.customer; });
+	std::stable_sort(people.begin(), people.end(), [](const customer & lhs, const customer & rhs) { return lhs.id < rhs.id; });
+
+	LINQ_CHECK(linq::from(orders).merge_join(linq::from(people), order_id, customer_id, combine).to_vector() == reference_join(orders, people, false));
+}
+
+LINQ_TEST(left_and_group_join_match_nested_loop)
+{
+	const std::vector<order>    orders = make_orders(2000, 100);
+	const std::vector<customer> people = make_customers(80, 150);
+
+	const auto left = linq::from(orders).left_join(linq::from(people), order_id, customer_id, [](const order & lhs, const customer * rhs)
+	{
+		return match(lhs.id, rhs != nullptr ? rhs->name : std::string("-"));
+	});
+
+	LINQ_CHECK(left.to_vector() == reference_join(orders, people, true));
+
+	const auto grouped = linq::from(orders).group_join(linq::from(people), order_id, customer_id, [](const order & lhs, const auto & matches)
+	{
+		return std::make_pair(lhs.id, linq::from(matches).select([](const customer & rhs) { return rhs.name; }).to_vector());
+	}).to_vector();
+
+	std::vector<match> flattened;
+	for (const auto & [id, names] : grouped)
+	{
+		for (const std::string & name : names)
+			flattened.emplace_back(id, name);
+	}
+
+	LINQ_CHECK(grouped.size() == orders.size());
+	LINQ_CHECK(flattened == reference_join(orders, people, false));
+}
+
+LINQ_TEST(lookup_keeps_first_seen_order)
+{
+	const std::vector<order> orders = make_orders(100000, 5000);
+
+	std::vector<int>              keys;
+	std::vector<std::vector<int>> groups(5000);
+	for (const order & value : orders)
+	{
+		if (groups[value.customer].empty())
+			keys.push_back(value.customer);
+
+		groups[value.customer].push_back(value.id);
+	}
+
+	const auto key = [](const order & value) { return value.customer; };
+
+	const auto sequential = linq::from(orders).to_lookup(key);
+	const auto parallel   = linq::from(orders).to_lookup(key, linq::parallel_policy{ 4, 0 });
+
+	for (const auto * lookup : { &sequential, &parallel })
+	{
+		std::size_t position = 0;
+		for (const auto & [group_key, group] : lookup->to_vector())
+		{
+			LINQ_CHECK(position < keys.size() && group_key == keys[position]);
+			LINQ_CHECK(linq::from(group).select([](const order & value) { return value.id; }).to_vector() == groups[group_key]);
+			++position;
+		}
+
+		LINQ_CHECK(position == keys.size());
+		LINQ_CHECK((*lookup)[keys.front()].select([](const order & value) { return value.id; }).to_vector() == groups[keys.front()]);
+		LINQ_CHECK(lookup->contains(keys.back()));
+		LINQ_CHECK(!lookup->contains(-1));
+		LINQ_CHECK(!lookup->try_get(-1).has_value());
+		LINQ_CHECK(lookup->try_get(keys.back()).has_value());
+	}
+}
\ No newline at end of file
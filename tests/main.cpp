@@ -0,0 +1,42 @@
+#include <cstring>
+#include <iostream>
+#include <exception>
+
+#include "test.hpp"
+
+/// <summary>
+/// Runs every test case, or the ones whose name contains the first argument.
+/// Returns the number of failed test cases.
+/// </summary>
+int main(int argc, char ** argv)
+{
+	const char * filter = argc > 1 ? argv[1] : "";
+
+	int passed = 0;
+	int failed = 0;
+
+	for (const linq::tests::test_case & test : linq::tests::registry())
+	{
+		if (std::strstr(test.name, filter) == nullptr)
+			continue;
+
+		try
+		{
+			test.run();
+			++passed;
+		}
+		catch (const linq::tests::check_failure & failure)
+		{
+			std::cout << "FAILED " << test.name << "\n  " << failure.message << "\n";
+			++failed;
+		}
+		catch (const std::exception & exception)
+		{
+			std::cout << "FAILED " << test.name << "\n  threw " << exception.what() << "\n";
+			++failed;
+		}
+	}
+
+	std::cout << passed << " passed, " << failed << " failed\n";
+	return failed;
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <set>
+#include <string>
+#include <vector>
+#include <compare>
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
+#include "test.hpp"
+
+namespace
+{
+
+	/// <summary>
+	/// Ordered but not hashable, so the sets fall back to ordered_set
+	/// </summary>
+	struct point
+	{
+		int x;
+		int y;
+
+		auto operator <=> (const point &) const = default;
+	};
+
+	std::vector<int> make_numbers(const std::size_t count, const std::size_t distinct_values)
+	{
+		std::vector<int> numbers(count);
+		for (int & value : numbers)
+			value = static_cast<int>(linq::tests::random_below(distinct_values));
+
+		return numbers;
+	}
+
+	std::vector<std::string> make_words(const std::size_t count, const std::size_t distinct_values)
+	{
+		std::vector<std::string> words(count);
+		for (std::string & value : words)
+			value = "word-with-a-long-prefix-" + std::to_string(linq::tests::random_below(distinct_values));
+
+		return words;
+	}
+
+	std::vector<point> make_points(const std::size_t count, const std::size_t distinct_values)
+	{
+		std::vector<point> points(count);
+		for (point & value : points)
+			value = point{ static_cast<int>(linq::tests::random_below(distinct_values)), static_cast<int>(linq::tests::random_below(3)) };
+
+		return points;
+	}
+
+	/// <summary>
+	/// The first occurrence of every value of lhs for which keep holds, in lhs order
+	/// </summary>
+	template<typename TValue, typename TKeep>
+	std::vector<TValue> reference_distinct(const std::vector<TValue> & lhs, const TKeep & keep)
+	{
+		std::vector<TValue> result;
+		std::set<TValue>    seen;
+
+		for (const TValue & value : lhs)
+		{
+			if (keep(value) && seen.insert(value).second)
+				result.push_back(value);
+		}
+
+		return result;
+	}
+
+	template<typename TValue>
+	bool contains(const std::vector<TValue> & values, const TValue & value)
+	{
+		return std::find(values.begin(), values.end(), value) != values.end();
+	}
+
+	/// <summary>
+	/// Checks the hash based set operations of one value type against the references
+	/// </summary>
+	template<typename TValue>
+	void check_set_operations(const std::vector<TValue> & lhs, const std::vector<TValue> & rhs)
+	{
+		const auto always  = [](const TValue &) { return true; };
+		const auto in_rhs  = [&rhs](const TValue & value) { return contains(rhs, value); };
+		const auto not_rhs = [&rhs](const TValue & value) { return !contains(rhs, value); };
+
+		LINQ_CHECK(linq::from(lhs).distinct().to_vector() == reference_distinct(lhs, always));
+		LINQ_CHECK(linq::from(lhs).except(linq::from(rhs)).to_vector() == reference_distinct(lhs, not_rhs));
+		LINQ_CHECK(linq::from(lhs).intersect_with(linq::from(rhs)).to_vector() == reference_distinct(lhs, in_rhs));
+
+		std::vector<TValue> duplicates;
+		std::copy_if(lhs.begin(), lhs.end(), std::back_inserter(duplicates), not_rhs);
+		LINQ_CHECK(linq::from(lhs).except_with_duplicates(linq::from(rhs)).to_vector() == duplicates);
+
+		std::vector<TValue> both = lhs;
+		both.insert(both.end(), rhs.begin(), rhs.end());
+		LINQ_CHECK(linq::from(lhs).union_with(linq::from(rhs)).to_vector() == reference_distinct(both, always));
+	}
+
+}
+
+LINQ_TEST(hashed_set_operations_match_reference)
+{
+	for (const std::size_t rhs_count : { 0, 10, 400, 5000 })
+	{
+		check_set_operations(make_numbers(2000, 500), make_numbers(rhs_count, 1000));
+		check_set_operations(make_words(2000, 500), make_words(rhs_count, 1000));
+	}
+}
+
+LINQ_TEST(ordered_set_operations_match_reference)
+{
+	for (const std::size_t rhs_count : { 0, 10, 400, 5000 })
+		check_set_operations(make_points(2000, 500), make_points(rhs_count, 1000));
+}
+
+LINQ_TEST(intersect_with_reads_unsized_ranges_in_lockstep)
+{
+	// where hides the sizes, so both ranges are read in lockstep until one ends
+	const auto any = [](const int) { return true; };
+
+	for (const std::size_t rhs_count : { 0, 1, 100, 4000 })
+	{
+		const std::vector<int> lhs = make_numbers(500, 300);
+		const std::vector<int> rhs = make_numbers(rhs_count, 600);
+
+		const auto in_rhs = [&rhs](const int value) { return contains(rhs, value); };
+
+		LINQ_CHECK(linq::from(lhs).where(any).intersect_with(linq::from(rhs).where(any)).to_vector() == reference_distinct(lhs, in_rhs));
+	}
+}
+
+LINQ_TEST(distinct_by_keeps_the_first_value_of_each_key)
+{
+	const std::vector<int> numbers = make_numbers(3000, 1000);
+
+	std::vector<int> expected;
+	std::set<int>    keys;
+	for (const int value : numbers)
+	{
+		if (keys.insert(value % 37).second)
+			expected.push_back(value);
+	}
+
+	LINQ_CHECK(linq::from(numbers).distinct_by([](const int value) { return value % 37; }).to_vector() == expected);
+}
+
+LINQ_TEST(except_approx_never_keeps_excluded_values)
+{
+	const std::vector<int> lhs = make_numbers(20000, 10000);
+	const std::vector<int> rhs = make_numbers(3000, 10000);
+
+	const std::unordered_set<int> excluded(rhs.begin(), rhs.end());
+	const std::vector<int>        result = linq::from(lhs).except_approx(linq::from(rhs)).to_vector();
+
+	std::size_t expected = 0;
+	for (const int value : lhs)
+		expected += excluded.count(value) == 0;
+
+	// false positives may drop a few more values, but never keep an excluded one
+	LINQ_CHECK(std::none_of(result.begin(), result.end(), [&excluded](const int value) { return excluded.count(value) != 0; }));
+	LINQ_CHECK(result.size() <= expected);
+	LINQ_CHECK(result.size() >= expected * 9 / 10);
+}
+
+LINQ_TEST(sorted_set_operations_match_std_set_operations)
+{
+	for (const std::size_t rhs_count : { 0, 10, 400, 5000 })
+	{
+		std::vector<int> lhs = make_numbers(2000, 1500);
+		std::vector<int> rhs = make_numbers(rhs_count, 1500);
+		std::sort(lhs.begin(), lhs.end());
+		std::sort(rhs.begin(), rhs.end());
+
+		const std::set<int> lhs_set(lhs.begin(), lhs.end());
+		const std::set<int> rhs_set(rhs.begin(), rhs.end());
+
+		std::vector<int> united, intersected, excepted;
+		std::set_union(lhs_set.begin(), lhs_set.end(), rhs_set.begin(), rhs_set.end(), std::back_inserter(united));
+		std::set_intersection(lhs_set.begin(), lhs_set.end(), rhs_set.begin(), rhs_set.end(), std::back_inserter(intersected));
+		std::set_difference(lhs_set.begin(), lhs_set.end(), rhs_set.begin(), rhs_set.end(), std::back_inserter(excepted));
+
+		LINQ_CHECK(linq::from(lhs).sorted_union_with(linq::from(rhs)).to_vector() == united);
+		LINQ_CHECK(linq::from(lhs).sorted_intersect_with(linq::from(rhs)).to_vector() == intersected);
+		LINQ_CHECK(linq::from(lhs).sorted_except(linq::from(rhs)).to_vector() == excepted);
+	}
+}
\ No newline at end of file
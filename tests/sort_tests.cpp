@@ -0,0 +1,232 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <algorithm>
+
+#include "test.hpp"
+
+namespace
+{
+
+	enum class color
+	{
+		red, green, blue
+	};
+
+	/// <summary>
+	/// Record with several sort keys, the id tells whether a sort was stable
+	/// </summary>
+	struct record
+	{
+		std::int64_t key;
+		double       weight;
+		color        tone;
+		int          id;
+
+		bool operator == (const record &) const = default;
+	};
+
+	std::vector<record> make_records(const std::size_t count, const std::size_t distinct_keys)
+	{
+		std::vector<record> records(count);
+
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			records[index] = record{
+				static_cast<std::int64_t>(linq::tests::random_below(distinct_keys)) - static_cast<std::int64_t>(distinct_keys / 2),
+				static_cast<double>(linq::tests::random_below(2000)) / 7.0 - 100.0,
+				static_cast<color>(linq::tests::random_below(3)),
+				static_cast<int>(index)
+			};
+		}
+
+		return records;
+	}
+
+	std::vector<std::string> make_strings(const std::size_t count)
+	{
+		static const char * prefixes[] = { "", "a", "ab", "abcdefgh", "abcdefghijklmnop", "zz" };
+
+		std::vector<std::string> strings(count);
+		for (std::string & value : strings)
+			value = std::string(prefixes[linq::tests::random_below(6)]) + std::to_string(linq::tests::random_below(count));
+
+		return strings;
+	}
+
+	template<typename TValue, typename TBefore>
+	std::vector<TValue> reference_sort(std::vector<TValue> values, const TBefore & before)
+	{
+		std::stable_sort(values.begin(), values.end(), before);
+		return values;
+	}
+
+	const auto by_key = [](const record & value) { return value.key; };
+
+	const auto key_ascending = [](const record & lhs, const record & rhs) { return lhs.key < rhs.key; };
+
+}
+
+LINQ_TEST(orderby_is_stable)
+{
+	for (const std::size_t count : { 0, 1, 2, 100, 5000 })
+	{
+		const std::vector<record> records = make_records(count, 50);
+
+		LINQ_CHECK(linq::from(records).orderby(by_key).to_vector() == reference_sort(records, key_ascending));
+		LINQ_CHECK(linq::from(records).orderby_descending(by_key).to_vector() == reference_sort(records, [](const record & lhs, const record & rhs) { return lhs.key > rhs.key; }));
+	}
+}
+
+LINQ_TEST(thenby_chains_compare_lexicographically)
+{
+	const std::vector<record> records = make_records(4000, 20);
+
+	const auto sorted = linq::from(records)
+		.orderby([](const record & value) { return value.tone; })
+		.thenby_descending(by_key)
+		.thenby([](const record & value) { return value.weight; })
+		.to_vector();
+
+	const auto expected = reference_sort(records, [](const record & lhs, const record & rhs)
+	{
+		if (lhs.tone != rhs.tone)
+			return lhs.tone < rhs.tone;
+
+		if (lhs.key != rhs.key)
+			return lhs.key > rhs.key;
+
+		return lhs.weight < rhs.weight;
+	});
+
+	LINQ_CHECK(sorted == expected);
+}
+
+LINQ_TEST(radix_keys_sort_like_comparisons)
+{
+	const std::vector<record> records = make_records(10000, 100000);
+
+	LINQ_CHECK(linq::from(records).orderby(by_key).to_vector() == reference_sort(records, key_ascending));
+
+	LINQ_CHECK(linq::from(records).orderby_descending([](const record & value) { return value.weight; }).to_vector() ==
+		reference_sort(records, [](const record & lhs, const record & rhs) { return lhs.weight > rhs.weight; }));
+
+	LINQ_CHECK(linq::from(records).orderby([](const record & value) { return value.tone; }).thenby(by_key).to_vector() ==
+		reference_sort(records, [](const record & lhs, const record & rhs) { return lhs.tone != rhs.tone ? lhs.tone < rhs.tone : lhs.key < rhs.key; }));
+}
+
+LINQ_TEST(string_keys_sort_like_comparisons)
+{
+	for (const std::size_t count : { 10, 63, 64, 5000 })
+	{
+		const std::vector<std::string> strings = make_strings(count);
+		const auto identity = [](const std::string & value) { return value; };
+
+		LINQ_CHECK(linq::from(strings).orderby(identity).to_vector() == reference_sort(strings, std::less<>()));
+		LINQ_CHECK(linq::from(strings).orderby_descending(identity).to_vector() == reference_sort(strings, std::greater<>()));
+	}
+}
+
+LINQ_TEST(string_view_keys_into_projected_values)
+{
+	// select yields the strings by value, so the string_view keys point into the
+	// values the sort stores itself, both short (inline) and heap allocated ones
+	const std::vector<std::string> strings = make_strings(3000);
+	const std::vector<std::string> expected = reference_sort(strings, std::less<>());
+
+	std::vector<std::size_t> positions(strings.size());
+	for (std::size_t index = 0; index < positions.size(); ++index)
+		positions[index] = index;
+
+	const auto project = [&strings](const std::size_t index) { return strings[index]; };
+	const auto view    = [](const std::string & value) { return std::string_view(value); };
+
+	LINQ_CHECK(linq::from(positions).select(project).orderby(view).to_vector() == expected);
+	LINQ_CHECK(linq::from(positions).select(project).orderby(view).take(10).to_vector() == std::vector<std::string>(expected.begin(), expected.begin() + 10));
+	LINQ_CHECK(linq::from(positions).select(project).orderby(view).element_at(1500) == expected[1500]);
+	LINQ_CHECK(linq::from(positions).select(project).orderby(view, linq::incremental).to_vector() == expected);
+
+	for (const std::size_t budget : { std::size_t(1), std::size_t(4096) })
+	{
+		linq::tests::scratch_directory directory;
+		const linq::external_sort_policy policy{ budget, directory.path };
+
+		LINQ_CHECK(linq::from(positions).select(project).orderby(view, policy).to_vector() == expected);
+		LINQ_CHECK(directory.empty());
+	}
+}
+
+LINQ_TEST(parallel_sort_matches_sequential_sort)
+{
+	const std::vector<record> records = make_records(200000, 1000);
+	const linq::parallel_policy policy{ 4, 0 };
+
+	LINQ_CHECK(linq::from(records).orderby(by_key, policy).to_vector() == reference_sort(records, key_ascending));
+
+	// a key the radix sort does not handle takes the parallel merge sort
+	const auto sorted = linq::from(records)
+		.orderby([](const record & value) { return std::to_string(value.key % 97); }, policy)
+		.to_vector();
+
+	LINQ_CHECK(sorted == reference_sort(records, [](const record & lhs, const record & rhs) { return std::to_string(lhs.key % 97) < std::to_string(rhs.key % 97); }));
+}
+
+LINQ_TEST(external_sort_matches_in_memory_sort)
+{
+	const std::vector<record> records = make_records(5000, 40);
+
+	// a one byte budget writes every value as its own run, forcing several merge passes
+	for (const std::size_t budget : { std::size_t(1), std::size_t(4096), std::size_t(1) << 30 })
+	{
+		linq::tests::scratch_directory directory;
+		const linq::external_sort_policy policy{ budget, directory.path };
+
+		LINQ_CHECK(linq::from(records).orderby(by_key, policy).to_vector() == reference_sort(records, key_ascending));
+
+		LINQ_CHECK(linq::from(records).orderby(by_key, policy).thenby_descending([](const record & value) { return value.id; }).to_vector() ==
+			reference_sort(records, [](const record & lhs, const record & rhs) { return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.id > rhs.id; }));
+
+		const std::vector<std::string> strings = make_strings(3000);
+		LINQ_CHECK(linq::from(strings).orderby_descending([](const std::string & value) { return value; }, policy).to_vector() == reference_sort(strings, std::greater<>()));
+
+		LINQ_CHECK(directory.empty());
+	}
+}
+
+LINQ_TEST(incremental_sort_matches_full_sort)
+{
+	const std::vector<record> records = make_records(3000, 30);
+	const auto expected = reference_sort(records, key_ascending);
+
+	LINQ_CHECK(linq::from(records).orderby(by_key, linq::incremental).to_vector() == expected);
+
+	const auto first = linq::from(records).orderby(by_key, linq::incremental).first();
+	LINQ_CHECK(first == expected.front());
+}
+
+LINQ_TEST(take_after_orderby_selects_the_top)
+{
+	const std::vector<record> records = make_records(3000, 30);
+	const auto expected = reference_sort(records, key_ascending);
+
+	for (const std::size_t count : { 0, 1, 10, 2999, 3000, 5000 })
+	{
+		const std::vector<record> top(expected.begin(), expected.begin() + std::min(count, expected.size()));
+		LINQ_CHECK(linq::from(records).orderby(by_key).take(count).to_vector() == top);
+	}
+}
+
+LINQ_TEST(rank_selection_matches_sorting)
+{
+	const std::vector<record> records = make_records(2001, 100000);
+	const auto expected = reference_sort(records, key_ascending);
+
+	for (const std::size_t rank : { 0, 1, 1000, 2000 })
+	{
+		LINQ_CHECK(linq::from(records).orderby(by_key).element_at(rank) == expected[rank]);
+		LINQ_CHECK(linq::from(records).nth_smallest(rank, by_key) == expected[rank]);
+	}
+
+	LINQ_CHECK(linq::from(records).median(by_key) == expected[1000]);
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <filesystem>
+
+#include <linq/enumerable.hpp>
+
+namespace linq::tests
+{
+
+	/// <summary>
+	/// A test case, registered before main runs
+	/// </summary>
+	struct test_case
+	{
+		const char * name;
+		void      (* run)();
+	};
+
+	/// <summary>
+	/// Returns all registered test cases
+	/// </summary>
+	inline std::vector<test_case> & registry()
+	{
+		static std::vector<test_case> cases;
+		return cases;
+	}
+
+	/// <summary>
+	/// Registers a test case through its constructor
+	/// </summary>
+	struct registrar
+	{
+		registrar(const char * name, void (* run)())
+		{
+			registry().push_back(test_case{ name, run });
+		}
+	};
+
+	/// <summary>
+	/// Thrown by LINQ_CHECK, aborts the current test case
+	/// </summary>
+	struct check_failure
+	{
+		std::string message;
+	};
+
+	[[noreturn]] inline void fail(const char * expression, const char * file, const int line)
+	{
+		throw check_failure{ std::string(file) + ":" + std::to_string(line) + ": " + expression };
+	}
+
+	/// <summary>
+	/// Random generator with a fixed seed, so failures can be reproduced
+	/// </summary>
+	inline std::mt19937_64 & random()
+	{
+		static std::mt19937_64 generator(0x5EED);
+		return generator;
+	}
+
+	/// <summary>
+	/// Returns a uniformly distributed number in [0, bound)
+	/// </summary>
+	inline std::size_t random_below(const std::size_t bound)
+	{
+		return static_cast<std::size_t>(random()() % bound);
+	}
+
+	/// <summary>
+	/// Empty directory for the temporary files of a test, removed again on destruction
+	/// </summary>
+	class scratch_directory
+	{
+	public:
+
+		scratch_directory()
+			: path(std::filesystem::temp_directory_path() / ("linq-tests-" + std::to_string(random()())))
+		{
+			std::filesystem::create_directories(this->path);
+		}
+
+		scratch_directory(const scratch_directory &) = delete;
+		scratch_directory & operator = (const scratch_directory &) = delete;
+
+		~scratch_directory()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(this->path, error);
+		}
+
+		/// <summary>
+		/// Checks whether every temporary file has been deleted again
+		/// </summary>
+		bool empty() const
+		{
+			return std::filesystem::is_empty(this->path);
+		}
+
+		std::filesystem::path path;
+	};
+
+}
+
+/// <summary>
+/// Defines and registers a test case
+/// </summary>
+#define LINQ_TEST(name)                                                               \
+	static void name();                                                               \
+	static const linq::tests::registrar name##_registrar(#name, &name);               \
+	static void name()
+
+/// <summary>
+/// Fails the current test case unless the expression holds
+/// </summary>
+#define LINQ_CHECK(expression) ((expression) ? void() : linq::tests::fail(#expression, __FILE__, __LINE__))
\ No newline at end of file